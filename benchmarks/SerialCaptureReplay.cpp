@@ -0,0 +1,206 @@
+/**
+ * @file SerialCaptureReplay.cpp
+ * @copyright LibSerial
+ *
+ * Replays a traffic capture recorded with SerialPort::StartCapture()
+ * through a pseudo-terminal at the recorded pacing, so production
+ * workloads can be reproduced at full rate against Read/ReadLine
+ * without the original hardware. The tool prints the slave device
+ * name; point a SerialPort (or any terminal program) at it and the
+ * recorded chunks arrive with their original inter-arrival times.
+ *
+ * Usage: serialCaptureReplay <capture-file> [start-delay-ms]
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <stdint.h>
+
+#include <fcntl.h>
+#include <pty.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace
+{
+    const char        CAPTURE_FILE_MAGIC[8]       = { 'L','S','C','A','P','0','1','\0' } ;
+    const std::size_t CAPTURE_HEADER_SIZE         = 4096 ;
+    const std::size_t CAPTURE_RECORD_HEADER_SIZE  = 16 ;
+
+    struct CaptureFileHeader
+    {
+        char     magic[8] ;
+        uint64_t dataCapacity ;
+        uint64_t headOffset ;
+        uint64_t tailOffset ;
+    } ;
+
+    //
+    // Copy bytes out of the capture data region at the given monotonic
+    // offset, wrapping at the region capacity.
+    //
+    void
+    ReadCaptureBytes( const unsigned char* captureData,
+                      const uint64_t       dataCapacity,
+                      const uint64_t       offset,
+                      unsigned char*       destination,
+                      const std::size_t    numOfBytes )
+    {
+        const uint64_t read_index     = offset % dataCapacity ;
+        const uint64_t bytes_till_end = dataCapacity - read_index ;
+        if ( numOfBytes <= bytes_till_end )
+        {
+            std::memcpy( destination, captureData + read_index, numOfBytes ) ;
+        }
+        else
+        {
+            std::memcpy( destination, captureData + read_index, bytes_till_end ) ;
+            std::memcpy( destination + bytes_till_end, captureData,
+                         numOfBytes - bytes_till_end ) ;
+        }
+    }
+}
+
+int
+main( int argc, char** argv )
+{
+    if ( argc < 2 )
+    {
+        fprintf( stderr, "Usage: %s <capture-file> [start-delay-ms]\n", argv[0] ) ;
+        return 1 ;
+    }
+    const int start_delay_ms = ( argc > 2 ) ? atoi(argv[2]) : 1000 ;
+
+    const int capture_fd = open( argv[1], O_RDONLY ) ;
+    if ( capture_fd < 0 )
+    {
+        perror( "open" ) ;
+        return 1 ;
+    }
+    struct stat file_info ;
+    if ( fstat( capture_fd, &file_info ) < 0 )
+    {
+        perror( "fstat" ) ;
+        return 1 ;
+    }
+    void* capture_mapping = mmap( 0, file_info.st_size, PROT_READ,
+                                  MAP_PRIVATE, capture_fd, 0 ) ;
+    if ( MAP_FAILED == capture_mapping )
+    {
+        perror( "mmap" ) ;
+        return 1 ;
+    }
+    const CaptureFileHeader* header =
+        static_cast<const CaptureFileHeader*>(capture_mapping) ;
+    if ( std::memcmp( header->magic, CAPTURE_FILE_MAGIC,
+                      sizeof(CAPTURE_FILE_MAGIC) ) != 0 )
+    {
+        fprintf( stderr, "%s is not a LibSerial capture file.\n", argv[1] ) ;
+        return 1 ;
+    }
+    const unsigned char* capture_data =
+        static_cast<const unsigned char*>(capture_mapping) + CAPTURE_HEADER_SIZE ;
+
+    int master_fd = -1 ;
+    int slave_fd  = -1 ;
+    char slave_name[128] ;
+    if ( openpty( &master_fd, &slave_fd, slave_name, 0, 0 ) < 0 )
+    {
+        perror( "openpty" ) ;
+        return 1 ;
+    }
+    printf( "%s\n", slave_name ) ;
+    fflush( stdout ) ;
+    usleep( start_delay_ms * 1000 ) ;
+
+    //
+    // Walk the records from the oldest retained one to the head,
+    // sleeping out the recorded inter-arrival gaps between chunks.
+    //
+    uint64_t offset = header->tailOffset ;
+    uint64_t total_bytes = 0 ;
+    uint64_t total_chunks = 0 ;
+    bool     have_previous_time = false ;
+    uint64_t previous_sec = 0 ;
+    uint32_t previous_nsec = 0 ;
+    while( offset < header->headOffset )
+    {
+        unsigned char record_header[CAPTURE_RECORD_HEADER_SIZE] ;
+        ReadCaptureBytes( capture_data, header->dataCapacity, offset,
+                          record_header, sizeof(record_header) ) ;
+        uint32_t payload_length = 0 ;
+        uint64_t arrival_sec    = 0 ;
+        uint32_t arrival_nsec   = 0 ;
+        std::memcpy( &payload_length, record_header,      4 ) ;
+        std::memcpy( &arrival_sec,    record_header + 4,  8 ) ;
+        std::memcpy( &arrival_nsec,   record_header + 12, 4 ) ;
+        //
+        // A record longer than the data region cannot have been
+        // written by the capture code; stop rather than trusting a
+        // corrupt length field.
+        //
+        if ( ( CAPTURE_RECORD_HEADER_SIZE + payload_length ) >
+             header->dataCapacity )
+        {
+            fprintf( stderr, "corrupt record at offset %llu; stopping.\n",
+                     (unsigned long long)offset ) ;
+            break ;
+        }
+
+        if ( have_previous_time )
+        {
+            const int64_t gap_ns =
+                ( arrival_sec - previous_sec ) * 1000000000LL +
+                ( (int64_t)arrival_nsec - (int64_t)previous_nsec ) ;
+            if ( gap_ns > 0 )
+            {
+                struct timespec gap ;
+                gap.tv_sec  = gap_ns / 1000000000LL ;
+                gap.tv_nsec = gap_ns % 1000000000LL ;
+                nanosleep( &gap, 0 ) ;
+            }
+        }
+        have_previous_time = true ;
+        previous_sec  = arrival_sec ;
+        previous_nsec = arrival_nsec ;
+
+        unsigned char* payload = new unsigned char[payload_length] ;
+        ReadCaptureBytes( capture_data, header->dataCapacity,
+                          offset + CAPTURE_RECORD_HEADER_SIZE,
+                          payload, payload_length ) ;
+        std::size_t bytes_written = 0 ;
+        while( bytes_written < payload_length )
+        {
+            const ssize_t write_result = write( master_fd,
+                                                payload + bytes_written,
+                                                payload_length - bytes_written ) ;
+            if ( write_result > 0 )
+            {
+                bytes_written += write_result ;
+            }
+            else
+            {
+                usleep(500) ;
+            }
+        }
+        delete [] payload ;
+        total_bytes  += payload_length ;
+        total_chunks += 1 ;
+        offset += CAPTURE_RECORD_HEADER_SIZE + payload_length ;
+    }
+    fprintf( stderr, "replayed %llu bytes in %llu chunks\n",
+             (unsigned long long)total_bytes,
+             (unsigned long long)total_chunks ) ;
+    //
+    // Give the reader a moment to drain the pty before it vanishes.
+    //
+    usleep( 500000 ) ;
+    close( master_fd ) ;
+    close( slave_fd ) ;
+    munmap( capture_mapping, file_info.st_size ) ;
+    close( capture_fd ) ;
+    return 0 ;
+}
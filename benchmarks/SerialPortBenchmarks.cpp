@@ -0,0 +1,464 @@
+/**
+ * @file SerialPortBenchmarks.cpp
+ * @copyright LibSerial
+ *
+ * A benchmark suite that measures the throughput and latency of the
+ * LibSerial read and write paths over a pseudo-terminal pair, so that
+ * performance changes can be validated without serial hardware.
+ *
+ * The suite reports, for each path:
+ *   - throughput in MB/s (bulk paths) or lines/s (ReadLine),
+ *   - per-operation latency percentiles (p50/p99/max),
+ *   - context switches per KB as a proxy for per-byte syscall and
+ *     scheduling overhead.
+ */
+
+#include <SerialPort.h>
+#include <SerialStream.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <pty.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace
+{
+    //
+    // Number of bytes pumped through the bulk benchmarks.
+    //
+    const std::size_t BULK_TRANSFER_BYTES = 8 * 1024 * 1024 ;
+
+    //
+    // Number of lines pumped through the ReadLine benchmark.
+    //
+    const int READLINE_NUM_LINES = 20000 ;
+
+    //
+    // Number of samples collected by the latency benchmarks.
+    //
+    const int LATENCY_NUM_SAMPLES = 2000 ;
+
+    double
+    MonotonicSeconds()
+    {
+        struct timespec now ;
+        clock_gettime( CLOCK_MONOTONIC, &now ) ;
+        return now.tv_sec + ( now.tv_nsec / 1e9 ) ;
+    }
+
+    long
+    ContextSwitches()
+    {
+        struct rusage usage ;
+        getrusage( RUSAGE_SELF, &usage ) ;
+        return usage.ru_nvcsw + usage.ru_nivcsw ;
+    }
+
+    //
+    // Return the value at the given percentile (0-100) of the samples.
+    //
+    double
+    Percentile( std::vector<double>& samples,
+                const double         percentile )
+    {
+        if ( samples.empty() )
+        {
+            return 0.0 ;
+        }
+        std::sort( samples.begin(), samples.end() ) ;
+        std::size_t index = static_cast<std::size_t>(
+            ( percentile / 100.0 ) * ( samples.size() - 1 ) ) ;
+        return samples[index] ;
+    }
+
+    //
+    // Parameters handed to the writer thread feeding the master side
+    // of the pty pair.
+    //
+    struct WriterArgs
+    {
+        int         masterFd ;
+        std::size_t totalBytes ;
+    } ;
+
+    void*
+    BulkWriterThread( void* arg )
+    {
+        const WriterArgs* args = static_cast<WriterArgs*>(arg) ;
+        unsigned char chunk[4096] ;
+        for( std::size_t i = 0 ; i < sizeof(chunk) ; ++i )
+        {
+            chunk[i] = static_cast<unsigned char>(i) ;
+        }
+        std::size_t bytes_sent = 0 ;
+        while( bytes_sent < args->totalBytes )
+        {
+            std::size_t bytes_to_send = sizeof(chunk) ;
+            if ( bytes_to_send > ( args->totalBytes - bytes_sent ) )
+            {
+                bytes_to_send = args->totalBytes - bytes_sent ;
+            }
+            const ssize_t result = write( args->masterFd,
+                                          chunk,
+                                          bytes_to_send ) ;
+            if ( result > 0 )
+            {
+                bytes_sent += result ;
+            }
+            else
+            {
+                usleep(100) ;
+            }
+        }
+        return 0 ;
+    }
+
+    void*
+    LineWriterThread( void* arg )
+    {
+        const WriterArgs* args = static_cast<WriterArgs*>(arg) ;
+        char line[128] ;
+        for( int i = 0 ; i < READLINE_NUM_LINES ; ++i )
+        {
+            const int length = snprintf( line,
+                                         sizeof(line),
+                                         "$GPGGA,%06d,4807.038,N,01131.000,E,1,08,0.9,545.4,M*7F\r\n",
+                                         i ) ;
+            int offset = 0 ;
+            while( offset < length )
+            {
+                const ssize_t result = write( args->masterFd,
+                                              line + offset,
+                                              length - offset ) ;
+                if ( result > 0 )
+                {
+                    offset += result ;
+                }
+                else
+                {
+                    usleep(100) ;
+                }
+            }
+        }
+        return 0 ;
+    }
+
+    void
+    ReportBulkResult( const char*              name,
+                      const std::size_t        totalBytes,
+                      const double             elapsedSeconds,
+                      const long               contextSwitches,
+                      const unsigned long long syscalls )
+    {
+        printf( "%-24s %8.1f MB/s   %6.2f ctxsw/KB   %6.3f syscalls/KB\n",
+                name,
+                ( totalBytes / ( 1024.0 * 1024.0 ) ) / elapsedSeconds,
+                contextSwitches / ( totalBytes / 1024.0 ),
+                syscalls / ( totalBytes / 1024.0 ) ) ;
+    }
+
+    unsigned long long
+    IoSyscallCount( const SerialPort& port )
+    {
+        const SerialPort::Statistics statistics = port.GetStatistics() ;
+        return statistics.readSyscalls + statistics.writeSyscalls ;
+    }
+
+    //
+    // Throughput of SerialPort::Read into a caller-provided buffer.
+    //
+    void
+    BenchmarkBulkRead( SerialPort& port,
+                       const int   masterFd )
+    {
+        WriterArgs args = { masterFd, BULK_TRANSFER_BYTES } ;
+        pthread_t writer ;
+        pthread_create( &writer, 0, BulkWriterThread, &args ) ;
+
+        unsigned char buffer[4096] ;
+        const double start_time = MonotonicSeconds() ;
+        const long   start_switches = ContextSwitches() ;
+        const unsigned long long start_syscalls = IoSyscallCount( port ) ;
+        std::size_t bytes_received = 0 ;
+        while( bytes_received < BULK_TRANSFER_BYTES )
+        {
+            port.Read( buffer, sizeof(buffer), 5000 ) ;
+            bytes_received += sizeof(buffer) ;
+        }
+        const double elapsed = MonotonicSeconds() - start_time ;
+        const long   switches = ContextSwitches() - start_switches ;
+        const unsigned long long syscalls = IoSyscallCount( port ) - start_syscalls ;
+        pthread_join( writer, 0 ) ;
+        ReportBulkResult( "SerialPort::Read", BULK_TRANSFER_BYTES, elapsed, switches, syscalls ) ;
+    }
+
+    //
+    // Throughput of the per-byte ReadByte path.
+    //
+    void
+    BenchmarkReadByte( SerialPort& port,
+                       const int   masterFd )
+    {
+        const std::size_t total_bytes = BULK_TRANSFER_BYTES / 16 ;
+        WriterArgs args = { masterFd, total_bytes } ;
+        pthread_t writer ;
+        pthread_create( &writer, 0, BulkWriterThread, &args ) ;
+
+        const double start_time = MonotonicSeconds() ;
+        const long   start_switches = ContextSwitches() ;
+        const unsigned long long start_syscalls = IoSyscallCount( port ) ;
+        for( std::size_t i = 0 ; i < total_bytes ; ++i )
+        {
+            port.ReadByte( 5000 ) ;
+        }
+        const double elapsed = MonotonicSeconds() - start_time ;
+        const long   switches = ContextSwitches() - start_switches ;
+        const unsigned long long syscalls = IoSyscallCount( port ) - start_syscalls ;
+        pthread_join( writer, 0 ) ;
+        ReportBulkResult( "SerialPort::ReadByte", total_bytes, elapsed, switches, syscalls ) ;
+    }
+
+    //
+    // Throughput of SerialPort::Write as seen by the writing side.
+    //
+    void
+    BenchmarkBulkWrite( SerialPort& port,
+                        const int   masterFd )
+    {
+        //
+        // Drain the master side in a thread so the writes do not
+        // stall on the pty buffer.
+        //
+        struct Drainer
+        {
+            static void* Run( void* arg )
+            {
+                const int fd = *static_cast<int*>(arg) ;
+                unsigned char sink[4096] ;
+                std::size_t bytes_drained = 0 ;
+                while( bytes_drained < BULK_TRANSFER_BYTES )
+                {
+                    const ssize_t result = read( fd, sink, sizeof(sink) ) ;
+                    if ( result > 0 )
+                    {
+                        bytes_drained += result ;
+                    }
+                    else
+                    {
+                        usleep(100) ;
+                    }
+                }
+                return 0 ;
+            }
+        } ;
+        int master_fd_arg = masterFd ;
+        pthread_t drainer ;
+        pthread_create( &drainer, 0, Drainer::Run, &master_fd_arg ) ;
+
+        unsigned char chunk[4096] ;
+        std::memset( chunk, 0x5A, sizeof(chunk) ) ;
+        const double start_time = MonotonicSeconds() ;
+        const long   start_switches = ContextSwitches() ;
+        const unsigned long long start_syscalls = IoSyscallCount( port ) ;
+        std::size_t bytes_sent = 0 ;
+        while( bytes_sent < BULK_TRANSFER_BYTES )
+        {
+            port.Write( chunk, sizeof(chunk) ) ;
+            bytes_sent += sizeof(chunk) ;
+        }
+        const double elapsed = MonotonicSeconds() - start_time ;
+        const long   switches = ContextSwitches() - start_switches ;
+        const unsigned long long syscalls = IoSyscallCount( port ) - start_syscalls ;
+        pthread_join( drainer, 0 ) ;
+        ReportBulkResult( "SerialPort::Write", BULK_TRANSFER_BYTES, elapsed, switches, syscalls ) ;
+    }
+
+    //
+    // Lines per second through ReadLine with a reused string.
+    //
+    void
+    BenchmarkReadLine( SerialPort& port,
+                       const int   masterFd )
+    {
+        WriterArgs args = { masterFd, 0 } ;
+        pthread_t writer ;
+        pthread_create( &writer, 0, LineWriterThread, &args ) ;
+
+        std::string line ;
+        const double start_time = MonotonicSeconds() ;
+        const long   start_switches = ContextSwitches() ;
+        std::size_t bytes_received = 0 ;
+        for( int i = 0 ; i < READLINE_NUM_LINES ; ++i )
+        {
+            port.ReadLine( line, 5000, '\n' ) ;
+            bytes_received += line.size() ;
+        }
+        const double elapsed = MonotonicSeconds() - start_time ;
+        const long   switches = ContextSwitches() - start_switches ;
+        pthread_join( writer, 0 ) ;
+        printf( "%-24s %8.0f lines/s %6.2f ctxsw/KB\n",
+                "SerialPort::ReadLine",
+                READLINE_NUM_LINES / elapsed,
+                switches / ( bytes_received / 1024.0 ) ) ;
+    }
+
+    //
+    // Throughput of bulk reads through the SerialStream interface.
+    //
+    void
+    BenchmarkSerialStream( const char* slaveName,
+                           const int   masterFd )
+    {
+        LibSerial::SerialStream stream ;
+        stream.Open( slaveName ) ;
+
+        WriterArgs args = { masterFd, BULK_TRANSFER_BYTES } ;
+        pthread_t writer ;
+        pthread_create( &writer, 0, BulkWriterThread, &args ) ;
+
+        char buffer[4096] ;
+        const double start_time = MonotonicSeconds() ;
+        const long   start_switches = ContextSwitches() ;
+        std::size_t bytes_received = 0 ;
+        while( bytes_received < BULK_TRANSFER_BYTES )
+        {
+            stream.read( buffer, sizeof(buffer) ) ;
+            bytes_received += stream.gcount() ;
+            if ( ! stream.good() )
+            {
+                stream.clear() ;
+            }
+        }
+        const double elapsed = MonotonicSeconds() - start_time ;
+        const long   switches = ContextSwitches() - start_switches ;
+        pthread_join( writer, 0 ) ;
+        stream.Close() ;
+        ReportBulkResult( "SerialStream::read", BULK_TRANSFER_BYTES, elapsed, switches, 0 ) ;
+    }
+
+    //
+    // Per-byte wakeup latency: the time from a byte being written to
+    // the master side until ReadByte returns it.
+    //
+    void
+    BenchmarkReadByteLatency( SerialPort& port,
+                              const int   masterFd )
+    {
+        std::vector<double> samples ;
+        samples.reserve( LATENCY_NUM_SAMPLES ) ;
+        const unsigned char probe_byte = 0xA5 ;
+        for( int i = 0 ; i < LATENCY_NUM_SAMPLES ; ++i )
+        {
+            const double start_time = MonotonicSeconds() ;
+            if ( write( masterFd, &probe_byte, 1 ) != 1 )
+            {
+                continue ;
+            }
+            port.ReadByte( 1000 ) ;
+            samples.push_back( ( MonotonicSeconds() - start_time ) * 1e6 ) ;
+        }
+        printf( "%-24s p50 %6.1f us   p99 %6.1f us   max %6.1f us\n",
+                "ReadByte latency",
+                Percentile( samples, 50 ),
+                Percentile( samples, 99 ),
+                Percentile( samples, 100 ) ) ;
+    }
+
+    //
+    // Submit latency of WriteAsync compared with synchronous Write.
+    //
+    void
+    BenchmarkWriteSubmitLatency( SerialPort& port,
+                                 const int   masterFd )
+    {
+        unsigned char frame[512] ;
+        std::memset( frame, 0x3C, sizeof(frame) ) ;
+        std::vector<double> sync_samples ;
+        std::vector<double> async_samples ;
+        sync_samples.reserve( LATENCY_NUM_SAMPLES ) ;
+        async_samples.reserve( LATENCY_NUM_SAMPLES ) ;
+
+        unsigned char sink[4096] ;
+        for( int i = 0 ; i < LATENCY_NUM_SAMPLES ; ++i )
+        {
+            double start_time = MonotonicSeconds() ;
+            port.Write( frame, sizeof(frame) ) ;
+            sync_samples.push_back( ( MonotonicSeconds() - start_time ) * 1e6 ) ;
+
+            start_time = MonotonicSeconds() ;
+            port.WriteAsync( frame, sizeof(frame) ) ;
+            async_samples.push_back( ( MonotonicSeconds() - start_time ) * 1e6 ) ;
+
+            //
+            // Keep the pty drained so neither path stalls on a full
+            // buffer.
+            //
+            while( read( masterFd, sink, sizeof(sink) ) > 0 )
+            {
+                /* drain */
+            }
+        }
+        port.WaitForAsyncWrites( 5000 ) ;
+        printf( "%-24s p50 %6.1f us   p99 %6.1f us\n",
+                "Write submit",
+                Percentile( sync_samples, 50 ),
+                Percentile( sync_samples, 99 ) ) ;
+        printf( "%-24s p50 %6.1f us   p99 %6.1f us\n",
+                "WriteAsync submit",
+                Percentile( async_samples, 50 ),
+                Percentile( async_samples, 99 ) ) ;
+    }
+}
+
+int
+main()
+{
+    int master_fd = -1 ;
+    int slave_fd  = -1 ;
+    char slave_name[128] ;
+    if ( openpty( &master_fd,
+                  &slave_fd,
+                  slave_name,
+                  0,
+                  0 ) < 0 )
+    {
+        perror( "openpty" ) ;
+        return 1 ;
+    }
+    //
+    // The master side is used in non-blocking mode throughout: the
+    // writer and drainer loops handle EAGAIN by backing off briefly.
+    //
+    fcntl( master_fd,
+           F_SETFL,
+           fcntl( master_fd, F_GETFL, 0 ) | O_NONBLOCK ) ;
+    printf( "LibSerial benchmarks (pty loopback on %s)\n\n", slave_name ) ;
+
+    {
+        SerialPort port( slave_name ) ;
+        port.Open() ;
+
+        BenchmarkBulkRead( port, master_fd ) ;
+        BenchmarkReadByte( port, master_fd ) ;
+        BenchmarkBulkWrite( port, master_fd ) ;
+        BenchmarkReadLine( port, master_fd ) ;
+        BenchmarkReadByteLatency( port, master_fd ) ;
+        BenchmarkWriteSubmitLatency( port, master_fd ) ;
+
+        port.Close() ;
+    }
+
+    BenchmarkSerialStream( slave_name, master_fd ) ;
+
+    close( master_fd ) ;
+    close( slave_fd ) ;
+    return 0 ;
+}
@@ -0,0 +1,121 @@
+/******************************************************************************
+ *   @file BufferPool.cpp                                                     *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#include "BufferPool.h"
+
+#include <iostream>
+
+namespace
+{
+    /*
+     * Create a new buffer with the specified capacity reserved.
+     */
+    SerialPort::DataBuffer*
+    CreateBuffer( const std::size_t bufferCapacity )
+    {
+        SerialPort::DataBuffer* data_buffer = new SerialPort::DataBuffer ;
+        data_buffer->reserve( bufferCapacity ) ;
+        return data_buffer ;
+    }
+}
+
+BufferPool::BufferPool( const std::size_t bufferCapacity,
+                        const std::size_t numOfBuffers ) :
+    mBufferCapacity(bufferCapacity),
+    mFreeBuffers(),
+    mAllBuffers(),
+    mPoolMutex()
+{
+    //Initializing the mutex
+    if ( pthread_mutex_init( &mPoolMutex,
+                             NULL ) != 0 )
+    {
+        std::cerr << "BufferPool.cpp: Could not initialize mutex!"
+                  << std::endl ;
+    }
+    mFreeBuffers.reserve( numOfBuffers ) ;
+    mAllBuffers.reserve( numOfBuffers ) ;
+    for( std::size_t i = 0 ; i < numOfBuffers ; ++i )
+    {
+        SerialPort::DataBuffer* data_buffer = CreateBuffer( mBufferCapacity ) ;
+        mFreeBuffers.push_back( data_buffer ) ;
+        mAllBuffers.push_back( data_buffer ) ;
+    }
+}
+
+BufferPool::~BufferPool()
+{
+    for( std::size_t i = 0 ; i < mAllBuffers.size() ; ++i )
+    {
+        delete mAllBuffers[i] ;
+    }
+    pthread_mutex_destroy( &mPoolMutex ) ;
+}
+
+SerialPort::DataBuffer*
+BufferPool::Acquire()
+{
+    SerialPort::DataBuffer* data_buffer = 0 ;
+    pthread_mutex_lock( &mPoolMutex ) ;
+    if ( ! mFreeBuffers.empty() )
+    {
+        data_buffer = mFreeBuffers.back() ;
+        mFreeBuffers.pop_back() ;
+        pthread_mutex_unlock( &mPoolMutex ) ;
+        return data_buffer ;
+    }
+    pthread_mutex_unlock( &mPoolMutex ) ;
+    //
+    // The pool is exhausted: grow it by one buffer instead of
+    // blocking the caller. The new buffer joins the pool's working
+    // set once it is released.
+    //
+    data_buffer = CreateBuffer( mBufferCapacity ) ;
+    pthread_mutex_lock( &mPoolMutex ) ;
+    mAllBuffers.push_back( data_buffer ) ;
+    pthread_mutex_unlock( &mPoolMutex ) ;
+    return data_buffer ;
+}
+
+void
+BufferPool::Release( SerialPort::DataBuffer* dataBuffer )
+{
+    if ( 0 == dataBuffer )
+    {
+        return ;
+    }
+    //
+    // Empty the buffer while retaining its reserved capacity so the
+    // next checkout starts from a clean slate without reallocating.
+    //
+    dataBuffer->resize(0) ;
+    pthread_mutex_lock( &mPoolMutex ) ;
+    mFreeBuffers.push_back( dataBuffer ) ;
+    pthread_mutex_unlock( &mPoolMutex ) ;
+    return ;
+}
+
+std::size_t
+BufferPool::GetAvailableCount() const
+{
+    pthread_mutex_lock( &mPoolMutex ) ;
+    const std::size_t available_count = mFreeBuffers.size() ;
+    pthread_mutex_unlock( &mPoolMutex ) ;
+    return available_count ;
+}
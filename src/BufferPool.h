@@ -0,0 +1,132 @@
+/******************************************************************************
+ *   @file BufferPool.h                                                       *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#ifndef _BufferPool_h_
+#define _BufferPool_h_
+
+#include <SerialPort.h>
+
+#include <pthread.h>
+#include <vector>
+
+/**
+ * @brief A pool of recycled, pre-sized DataBuffer instances.
+ *
+ *        Callers that construct a fresh DataBuffer per message pay a
+ *        heap allocation for every read and every write. A BufferPool
+ *        instead keeps a fixed set of buffers with their capacity
+ *        already reserved: Acquire() checks a buffer out, the
+ *        application fills it straight from a bulk read (or hands it
+ *        to a write), and Release() returns it with its capacity
+ *        intact. In steady state no allocator calls are made at all.
+ *        Typical use:
+ *
+ *        \code
+ *        BufferPool pool(4096, 16) ;
+ *        SerialPort::DataBuffer* buffer = pool.Acquire() ;
+ *        buffer->resize(frameSize) ;
+ *        port.Read( &(*buffer)[0], frameSize, msTimeout ) ;
+ *        // ... process or WriteAsync the buffer ...
+ *        pool.Release(buffer) ;
+ *        \endcode
+ *
+ *        If the pool is exhausted, Acquire() allocates an additional
+ *        buffer rather than blocking; the pool grows to the
+ *        application's working-set size and then stops allocating.
+ *        Acquire() and Release() may be called from different
+ *        threads.
+ */
+class BufferPool
+{
+public:
+    /**
+     * @brief Creates a pool holding numOfBuffers buffers, each with a
+     *        capacity of bufferCapacity bytes reserved up front.
+     * @param bufferCapacity The number of bytes reserved in each
+     *        buffer.
+     * @param numOfBuffers The number of buffers created up front.
+     */
+    BufferPool( const std::size_t bufferCapacity,
+                const std::size_t numOfBuffers ) ;
+
+    /**
+     * @brief Destructor. All buffers obtained from the pool must have
+     *        been released before the pool is destroyed.
+     */
+    ~BufferPool() ;
+
+    /**
+     * @brief Checks a buffer out of the pool. The buffer is empty but
+     *        its previously reserved capacity is retained. If no
+     *        buffer is available, a new one is allocated and added to
+     *        the pool's working set.
+     * @return Returns a buffer owned by the pool.
+     */
+    SerialPort::DataBuffer*
+    Acquire() ;
+
+    /**
+     * @brief Returns a buffer to the pool for reuse. The buffer must
+     *        have been obtained from this pool with Acquire().
+     * @param dataBuffer The buffer to be returned.
+     */
+    void
+    Release( SerialPort::DataBuffer* dataBuffer ) ;
+
+    /**
+     * @brief Gets the number of buffers currently available for
+     *        checkout.
+     * @return Returns the number of available buffers.
+     */
+    std::size_t
+    GetAvailableCount() const ;
+
+private:
+    /**
+     * The copy constructor and the assignment operator are declared
+     * private but never defined. This allows the compiler to catch
+     * attempts to copy instances of this class.
+     */
+    BufferPool( const BufferPool& ) ;
+    BufferPool& operator=( const BufferPool& ) ;
+
+    /**
+     * The capacity reserved in each buffer of the pool.
+     */
+    const std::size_t mBufferCapacity ;
+
+    /**
+     * Buffers currently available for checkout.
+     */
+    std::vector<SerialPort::DataBuffer*> mFreeBuffers ;
+
+    /**
+     * All buffers owned by the pool, both checked out and free. Used
+     * to release the storage when the pool is destroyed.
+     */
+    std::vector<SerialPort::DataBuffer*> mAllBuffers ;
+
+    /**
+     * Mutex protecting the buffer lists so that buffers can be
+     * acquired and released from different threads.
+     */
+    mutable pthread_mutex_t mPoolMutex ;
+} ;
+
+#endif // #ifndef _BufferPool_h_
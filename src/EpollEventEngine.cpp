@@ -0,0 +1,421 @@
+/******************************************************************************
+ *   @file EpollEventEngine.cpp                                               *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#include "EpollEventEngine.h"
+#include "EpollEventHandler.h"
+
+#include <cstring>
+#include <stdint.h>
+#include <map>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+
+
+namespace
+{
+    /**
+     * Implementation class for the EpollEventEngine.
+     */
+    class EpollEventEngineImpl
+    {
+    public:
+        /*
+         * As in the case of EpollEventEngine, this is also a singleton
+         * class. The only instance of this class can be obtained using
+         * this method.
+         */
+        static
+        EpollEventEngineImpl&
+        Instance() ;
+
+        /*
+         * Implementation of EpollEventEngine::AttachHandler()
+         */
+        void
+        AttachHandler( const int          fileDescriptor,
+                       EpollEventHandler& eventHandler ) ;
+
+        /*
+         * Implementation of EpollEventEngine::DetachHandler()
+         */
+        void
+        DetachHandler( const int fileDescriptor ) ;
+
+        /*
+         * Implementation of EpollEventEngine::SetHandlerEvents()
+         */
+        void
+        SetHandlerEvents( const int  fileDescriptor,
+                          const bool readEventsEnabled,
+                          const bool writeEventsEnabled ) ;
+
+        /*
+         * Implementation of EpollEventEngine::SynchronizeWithDispatch()
+         */
+        void
+        SynchronizeWithDispatch() ;
+    private:
+        /*
+         * Maximum number of events retrieved by a single call to
+         * epoll_wait().
+         */
+        enum { MAX_EPOLL_EVENTS = 64 } ;
+
+        /*
+         * List of event handlers that are currently attached to the
+         * engine, indexed by file descriptor.
+         */
+        typedef std::map<int, EpollEventHandler*> EventHandlerList ;
+        static EventHandlerList mEventHandlerList ;
+
+        /*
+         * Mutex protecting mEventHandlerList. The event loop holds
+         * this mutex while dispatching to a handler, so once
+         * DetachHandler() has acquired it and removed an entry, no
+         * further calls to the corresponding handler can be in
+         * progress.
+         */
+        static pthread_mutex_t mHandlerListMutex ;
+
+        /*
+         * The epoll file descriptor all monitored file descriptors are
+         * registered with. This is -1 until the first handler is
+         * attached.
+         */
+        static int mEpollFileDescriptor ;
+
+        /*
+         * Flag indicating whether the event loop thread has been
+         * created.
+         */
+        static bool mEventLoopThreadRunning ;
+
+        /*
+         * The background thread executing the event loop.
+         */
+        static pthread_t mEventLoopThread ;
+
+        /*
+         * Default constructor.
+         */
+        EpollEventEngineImpl() ;
+
+        /*
+         * Destructor.
+         */
+        ~EpollEventEngineImpl() ;
+
+        /*
+         * Static function executed by the event loop thread. It waits
+         * for readiness events on the epoll file descriptor and
+         * dispatches them to the attached handlers.
+         */
+        static
+        void*
+        EventLoopThreadFunc( void* unusedParameter ) ;
+    } ;
+
+    //
+    // Initialization of static members of class EpollEventEngineImpl.
+    //
+    EpollEventEngineImpl::EventHandlerList
+    EpollEventEngineImpl::mEventHandlerList ;
+
+    pthread_mutex_t
+    EpollEventEngineImpl::mHandlerListMutex = PTHREAD_MUTEX_INITIALIZER ;
+
+    int
+    EpollEventEngineImpl::mEpollFileDescriptor = -1 ;
+
+    bool
+    EpollEventEngineImpl::mEventLoopThreadRunning = false ;
+
+    pthread_t
+    EpollEventEngineImpl::mEventLoopThread ;
+}
+
+EpollEventEngine::EpollEventEngine()
+{
+    /* empty */
+}
+
+EpollEventEngine::~EpollEventEngine()
+{
+    /* empty */
+}
+
+EpollEventEngine&
+EpollEventEngine::Instance()
+{
+    static EpollEventEngine single_instance ;
+    return single_instance ;
+}
+
+void
+EpollEventEngine::AttachHandler( const int          fileDescriptor,
+                                 EpollEventHandler& eventHandler )
+{
+    EpollEventEngineImpl::Instance().AttachHandler( fileDescriptor,
+                                                    eventHandler ) ;
+    return ;
+}
+
+void
+EpollEventEngine::DetachHandler( const int fileDescriptor )
+{
+    EpollEventEngineImpl::Instance().DetachHandler( fileDescriptor ) ;
+    return ;
+}
+
+void
+EpollEventEngine::SetHandlerEvents( const int  fileDescriptor,
+                                    const bool readEventsEnabled,
+                                    const bool writeEventsEnabled )
+{
+    EpollEventEngineImpl::Instance().SetHandlerEvents( fileDescriptor,
+                                                       readEventsEnabled,
+                                                       writeEventsEnabled ) ;
+    return ;
+}
+
+void
+EpollEventEngine::SynchronizeWithDispatch()
+{
+    EpollEventEngineImpl::Instance().SynchronizeWithDispatch() ;
+    return ;
+}
+
+namespace
+{
+    inline
+    EpollEventEngineImpl::EpollEventEngineImpl()
+    {
+        /* empty */
+    }
+
+    inline
+    EpollEventEngineImpl::~EpollEventEngineImpl()
+    {
+        /* empty */
+    }
+
+    inline
+    EpollEventEngineImpl&
+    EpollEventEngineImpl::Instance()
+    {
+        static EpollEventEngineImpl single_instance ;
+        return single_instance ;
+    }
+
+    inline
+    void
+    EpollEventEngineImpl::AttachHandler( const int          fileDescriptor,
+                                         EpollEventHandler& eventHandler )
+    {
+        pthread_mutex_lock( &mHandlerListMutex ) ;
+        //
+        // Create the epoll file descriptor and the event loop thread
+        // the first time a handler is attached.
+        //
+        if ( -1 == mEpollFileDescriptor )
+        {
+            mEpollFileDescriptor = epoll_create1( 0 ) ;
+            if ( mEpollFileDescriptor < 0 )
+            {
+                pthread_mutex_unlock( &mHandlerListMutex ) ;
+                throw EpollEventEngine::CannotAttachHandler( strerror(errno) ) ;
+            }
+        }
+        if ( ! mEventLoopThreadRunning )
+        {
+            if ( pthread_create( &mEventLoopThread,
+                                 0,
+                                 EventLoopThreadFunc,
+                                 0 ) != 0 )
+            {
+                pthread_mutex_unlock( &mHandlerListMutex ) ;
+                throw EpollEventEngine::CannotAttachHandler( strerror(errno) ) ;
+            }
+            pthread_detach( mEventLoopThread ) ;
+            mEventLoopThreadRunning = true ;
+        }
+        //
+        // Register the file descriptor with the epoll instance and
+        // store the corresponding handler. The epoll_ctl() call takes
+        // effect even while the event loop is blocked in epoll_wait().
+        //
+        struct epoll_event epoll_event_info ;
+        std::memset( &epoll_event_info,
+                     0,
+                     sizeof(epoll_event_info) ) ;
+        epoll_event_info.events  = EPOLLIN ;
+        epoll_event_info.data.fd = fileDescriptor ;
+        if ( epoll_ctl( mEpollFileDescriptor,
+                        EPOLL_CTL_ADD,
+                        fileDescriptor,
+                        &epoll_event_info ) < 0 )
+        {
+            pthread_mutex_unlock( &mHandlerListMutex ) ;
+            throw EpollEventEngine::CannotAttachHandler( strerror(errno) ) ;
+        }
+        mEventHandlerList[ fileDescriptor ] = &eventHandler ;
+        pthread_mutex_unlock( &mHandlerListMutex ) ;
+        return ;
+    }
+
+    inline
+    void
+    EpollEventEngineImpl::DetachHandler( const int fileDescriptor )
+    {
+        //
+        // Remove the file descriptor from the epoll instance first so
+        // that no new events are generated for it, then remove the
+        // handler from the list. Acquiring mHandlerListMutex
+        // guarantees that any dispatch in progress for this handler
+        // has completed before this method returns.
+        //
+        pthread_mutex_lock( &mHandlerListMutex ) ;
+        EventHandlerList::iterator handler_iterator =
+            mEventHandlerList.find( fileDescriptor ) ;
+        if ( mEventHandlerList.end() == handler_iterator )
+        {
+            pthread_mutex_unlock( &mHandlerListMutex ) ;
+            throw EpollEventEngine::CannotDetachHandler(
+                "The specified file descriptor is not attached to the engine." ) ;
+        }
+        if ( epoll_ctl( mEpollFileDescriptor,
+                        EPOLL_CTL_DEL,
+                        fileDescriptor,
+                        0 ) < 0 )
+        {
+            pthread_mutex_unlock( &mHandlerListMutex ) ;
+            throw EpollEventEngine::CannotDetachHandler( strerror(errno) ) ;
+        }
+        mEventHandlerList.erase( handler_iterator ) ;
+        pthread_mutex_unlock( &mHandlerListMutex ) ;
+        return ;
+    }
+
+    inline
+    void
+    EpollEventEngineImpl::SynchronizeWithDispatch()
+    {
+        //
+        // The event loop holds mHandlerListMutex while dispatching to
+        // a handler, so acquiring it guarantees any dispatch that was
+        // in progress has completed.
+        //
+        pthread_mutex_lock( &mHandlerListMutex ) ;
+        pthread_mutex_unlock( &mHandlerListMutex ) ;
+        return ;
+    }
+
+    inline
+    void
+    EpollEventEngineImpl::SetHandlerEvents( const int  fileDescriptor,
+                                            const bool readEventsEnabled,
+                                            const bool writeEventsEnabled )
+    {
+        //
+        // Change the monitored events for the file descriptor without
+        // removing it from the epoll instance. Errors are ignored
+        // here: the worst outcome of a failed modification is a few
+        // extra (or a few delayed) calls to the handler.
+        //
+        struct epoll_event epoll_event_info ;
+        std::memset( &epoll_event_info,
+                     0,
+                     sizeof(epoll_event_info) ) ;
+        epoll_event_info.events  =
+            ( readEventsEnabled  ? static_cast<uint32_t>(EPOLLIN)  : 0u ) |
+            ( writeEventsEnabled ? static_cast<uint32_t>(EPOLLOUT) : 0u ) ;
+        epoll_event_info.data.fd = fileDescriptor ;
+        epoll_ctl( mEpollFileDescriptor,
+                   EPOLL_CTL_MOD,
+                   fileDescriptor,
+                   &epoll_event_info ) ;
+        return ;
+    }
+
+    void*
+    EpollEventEngineImpl::EventLoopThreadFunc( void* /* unusedParameter */ )
+    {
+        struct epoll_event epoll_events[ MAX_EPOLL_EVENTS ] ;
+        while( true )
+        {
+            const int num_of_events = epoll_wait( mEpollFileDescriptor,
+                                                  epoll_events,
+                                                  MAX_EPOLL_EVENTS,
+                                                  -1 ) ;
+            if ( num_of_events < 0 )
+            {
+                if ( EINTR == errno )
+                {
+                    continue ;
+                }
+                //
+                // An unrecoverable error on the epoll file descriptor;
+                // terminate the event loop.
+                //
+                break ;
+            }
+            for( int i = 0 ; i < num_of_events ; ++i )
+            {
+                const int ready_fd = epoll_events[i].data.fd ;
+                //
+                // The handler is looked up and invoked with the list
+                // mutex held so that DetachHandler() can guarantee
+                // that no dispatch is in progress after it returns.
+                //
+                pthread_mutex_lock( &mHandlerListMutex ) ;
+                EventHandlerList::iterator handler_iterator =
+                    mEventHandlerList.find( ready_fd ) ;
+                if ( mEventHandlerList.end() != handler_iterator )
+                {
+                    if ( epoll_events[i].events & EPOLLOUT )
+                    {
+                        handler_iterator->second->HandleWriteEvent() ;
+                    }
+                    if ( epoll_events[i].events & EPOLLIN )
+                    {
+                        handler_iterator->second->HandleReadEvent() ;
+                    }
+                    else if ( epoll_events[i].events & ( EPOLLHUP | EPOLLERR ) )
+                    {
+                        //
+                        // The descriptor can no longer produce data.
+                        // Give the handler one last chance to observe
+                        // the condition and then stop monitoring the
+                        // descriptor so that the level-triggered event
+                        // loop does not spin on it.
+                        //
+                        handler_iterator->second->HandleReadEvent() ;
+                        Instance().SetHandlerEvents( ready_fd,
+                                                     false,
+                                                     false ) ;
+                    }
+                }
+                pthread_mutex_unlock( &mHandlerListMutex ) ;
+            }
+        }
+        return 0 ;
+    }
+}
@@ -0,0 +1,171 @@
+/******************************************************************************
+ *   @file EpollEventEngine.h                                                 *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#ifndef _EpollEventEngine_h_
+#define _EpollEventEngine_h_
+
+#include <stdexcept>
+
+/**
+ * @brief Forward declarations.
+ */
+class EpollEventHandler ;
+
+/**
+ * @brief An I/O readiness engine based on epoll. The engine owns a
+ *        single epoll file descriptor and a background event loop
+ *        thread. File descriptors of all open serial ports are
+ *        registered with the engine and the HandleReadEvent() method
+ *        of the corresponding handler is invoked from the event loop
+ *        whenever a descriptor becomes readable.
+ *
+ *        Unlike the SIGIO mechanism used by earlier versions of this
+ *        library, epoll readiness events are per-descriptor and are
+ *        delivered in ordinary thread context: they cannot be coalesced
+ *        across ports, do not interfere with any signal handling in the
+ *        rest of the application, and dispatching is O(number of ready
+ *        descriptors) regardless of how many ports are open.
+ *
+ * @note Handlers are invoked with an internal lock held, so a handler
+ *       must not call AttachHandler() or DetachHandler() from within
+ *       HandleReadEvent().
+ */
+class EpollEventEngine
+{
+public:
+    /**
+     * @brief This is a singleton class and there is only one instance of
+     *        this class per process. This instance can be obtained using
+     *        the Instance() method.
+     */
+    static EpollEventEngine& Instance() ;
+
+    /**
+     * @brief Exception thrown when AttachHandler() fails due to a runtime
+     *        error.
+     */
+    class CannotAttachHandler : public std::runtime_error
+    {
+    public:
+        CannotAttachHandler( const std::string& whatArg ) :
+            runtime_error(whatArg) { }
+    } ;
+
+    /**
+     * @brief Exception thrown when DetachHandler() fails due to a runtime
+     *        error.
+     */
+    class CannotDetachHandler : public std::runtime_error
+    {
+    public:
+        CannotDetachHandler( const std::string& whatArg ) :
+            runtime_error(whatArg) { }
+    } ;
+
+    /**
+     * @brief Starts delivering read events for the specified file
+     *        descriptor to the specified handler. The event loop thread
+     *        is created on the first call to this method. The handler
+     *        should not be destroyed while it is attached to the
+     *        engine; make sure DetachHandler() is called from the
+     *        destructor of the handler.
+     *
+     * @param fileDescriptor The file descriptor to be monitored for
+     *        available data.
+     * @param eventHandler The handler to be invoked when fileDescriptor
+     *        becomes readable.
+     * @throw CannotAttachHandler This exception is thrown if the method
+     *        cannot attach the handler.
+     */
+    void AttachHandler( const int          fileDescriptor,
+                        EpollEventHandler& eventHandler ) ;
+
+    /**
+     * @brief Stops delivering read events for the specified file
+     *        descriptor. When this method returns, no further calls to
+     *        the corresponding handler will be made and no call is in
+     *        progress, so it is safe to destroy the handler.
+     *
+     * @param fileDescriptor The file descriptor to stop monitoring.
+     * @throw CannotDetachHandler This exception is thrown if the method
+     *        cannot detach the handler.
+     */
+    void DetachHandler( const int fileDescriptor ) ;
+
+    /**
+     * @brief Selects which events are delivered for the specified file
+     *        descriptor while keeping the handler attached. Handlers
+     *        disable read events when their input buffers are full
+     *        (leaving the descriptor armed would make the
+     *        level-triggered event loop spin on it) and enable write
+     *        events only while they have data queued for transmission.
+     *        The caller is responsible for serializing invocations of
+     *        this method for a given file descriptor so that the last
+     *        applied mask reflects the latest state.
+     *
+     * @param fileDescriptor The file descriptor whose event mask is to
+     *        be changed.
+     * @param readEventsEnabled True iff the handler's HandleReadEvent()
+     *        should be called when the descriptor becomes readable.
+     * @param writeEventsEnabled True iff the handler's
+     *        HandleWriteEvent() should be called when the descriptor
+     *        becomes writable.
+     */
+    void SetHandlerEvents( const int  fileDescriptor,
+                           const bool readEventsEnabled,
+                           const bool writeEventsEnabled ) ;
+
+    /**
+     * @brief Waits until any handler dispatch currently in progress on
+     *        the event loop has completed. Changing a handler's event
+     *        mask with SetHandlerEvents() does not interrupt a
+     *        dispatch already running; callers that need a hard
+     *        guarantee that no further calls into a handler are in
+     *        flight (for example before handing its buffers to
+     *        another thread) call this method after changing the
+     *        mask.
+     */
+    void SynchronizeWithDispatch() ;
+
+private:
+    /**
+     * @brief This is a singleton class and the only instance of this
+     *        class can only be accessed using the Instance() method.
+     *        This is enforced by making the default constructor a
+     *        private member disallowing construction of new instances
+     *        of this class.
+     */
+    EpollEventEngine() ;
+
+    /**
+     * @brief This class is not meant to be subclassed. The destructor
+     *        is declared private to enforce this.
+     */
+    ~EpollEventEngine() ;
+
+    /**
+     * @brief Copying of an instance of this class is not allowed. The
+     *        copy constructor and the assignment operator are declared
+     *        private but never defined.
+     */
+    EpollEventEngine( const EpollEventEngine& otherInstance ) ;
+    EpollEventEngine& operator=( const EpollEventEngine& otherInstance ) ;
+} ;
+
+#endif // #ifndef _EpollEventEngine_h_
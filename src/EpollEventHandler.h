@@ -0,0 +1,63 @@
+/******************************************************************************
+ *   @file EpollEventHandler.h                                                *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#ifndef _EpollEventHandler_h_
+#define _EpollEventHandler_h_
+
+/**
+ * @brief Gets a method called when the corresponding file descriptor
+ *        becomes readable. An EpollEventHandler must be attached to the
+ *        EpollEventEngine for it to be called.
+ */
+class EpollEventHandler
+{
+public:
+    /**
+     * @brief This method is called from the event loop of the
+     *        EpollEventEngine when the file descriptor associated with
+     *        this handler has data available for reading. It is always
+     *        called from the event loop thread of the engine, never
+     *        from a signal handler.
+     */
+    virtual void HandleReadEvent() = 0 ;
+
+    /**
+     * @brief This method is called from the event loop of the
+     *        EpollEventEngine when the file descriptor associated with
+     *        this handler can accept more data for writing, provided
+     *        write events have been enabled for the descriptor with
+     *        EpollEventEngine::SetHandlerEvents(). The default
+     *        implementation does nothing.
+     */
+    virtual void HandleWriteEvent() { /* empty */ }
+
+    /**
+     * @brief Destructor is declared virtual as we expect this class to be
+     *        subclassed. It is also declared pure abstract to make this
+     *        class a pure abstract class.
+     */
+    virtual ~EpollEventHandler() = 0 ;
+} ;
+
+inline
+EpollEventHandler::~EpollEventHandler()
+{
+    /* empty */
+}
+#endif // #ifndef _EpollEventHandler_h_
@@ -49,17 +49,14 @@ namespace
          */
         void
         AttachHandler( const int           posixSignalNumber,
-                       PosixSignalHandler& signalHandler )
-        throw( PosixSignalDispatcher::CannotAttachHandler ) ;
+                       PosixSignalHandler& signalHandler ) ;
 
         /*
          * Implementation of PosixSignalDispatcher::DetachHandler()
          */
         void
         DetachHandler( const int                 posixSignalNumber,
-                       const PosixSignalHandler& signalHandler )
-        throw( PosixSignalDispatcher::CannotDetachHandler,
-               std::logic_error ) ;
+                       const PosixSignalHandler& signalHandler ) ;
     private:
         /*
          * List of signal handlers that are currently associated
@@ -125,7 +122,6 @@ PosixSignalDispatcher::Instance()
 void
 PosixSignalDispatcher::AttachHandler( const int           posixSignalNumber,
                                       PosixSignalHandler& signalHandler )
-    throw( CannotAttachHandler )
 {
     PosixSignalDispatcherImpl::Instance().AttachHandler( posixSignalNumber,
             signalHandler ) ;
@@ -135,8 +131,6 @@ PosixSignalDispatcher::AttachHandler( const int           posixSignalNumber,
 void
 PosixSignalDispatcher::DetachHandler( const int                 posixSignalNumber,
                                       const PosixSignalHandler& signalHandler )
-    throw( CannotDetachHandler,
-           std::logic_error )
 {
     PosixSignalDispatcherImpl::Instance().DetachHandler( posixSignalNumber,
             signalHandler ) ;
@@ -169,7 +163,6 @@ namespace
     PosixSignalDispatcherImpl::AttachHandler(
         const int           posixSignalNumber,
         PosixSignalHandler& signalHandler )
-    throw( PosixSignalDispatcher::CannotAttachHandler )
     {
         /*
          * Attach this instance of PosixSignalDispatcher to the specified
@@ -212,8 +205,6 @@ namespace
     PosixSignalDispatcherImpl::DetachHandler(
         const int                 posixSignalNumber,
         const PosixSignalHandler& signalHandler )
-    throw( PosixSignalDispatcher::CannotDetachHandler,
-           std::logic_error )
     {
         /*
          * Get the range of values in the SignalHandlerList corresponding
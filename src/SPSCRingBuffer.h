@@ -0,0 +1,499 @@
+/******************************************************************************
+ *   @file SPSCRingBuffer.h                                                   *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#ifndef _SPSCRingBuffer_h_
+#define _SPSCRingBuffer_h_
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Index policy for ring buffers whose producer and consumer
+ *        run on different threads. The indices are atomic and updates
+ *        are published with release/acquire ordering.
+ */
+struct AtomicRingIndexPolicy
+{
+    typedef std::atomic<std::size_t> Index ;
+
+    static std::size_t
+    LoadAcquire( const Index& index )
+    {
+        return index.load(std::memory_order_acquire) ;
+    }
+
+    static std::size_t
+    LoadRelaxed( const Index& index )
+    {
+        return index.load(std::memory_order_relaxed) ;
+    }
+
+    static void
+    StoreRelease( Index&            index,
+                  const std::size_t value )
+    {
+        index.store( value,
+                     std::memory_order_release ) ;
+    }
+} ;
+
+/**
+ * @brief Index policy for ring buffers whose producer and consumer
+ *        run on the same thread (for example a polling loop that both
+ *        fills and drains the buffer). The indices are plain integers
+ *        and every synchronization operation compiles away.
+ */
+struct SingleThreadedRingIndexPolicy
+{
+    typedef std::size_t Index ;
+
+    static std::size_t
+    LoadAcquire( const Index& index )
+    {
+        return index ;
+    }
+
+    static std::size_t
+    LoadRelaxed( const Index& index )
+    {
+        return index ;
+    }
+
+    static void
+    StoreRelease( Index&            index,
+                  const std::size_t value )
+    {
+        index = value ;
+    }
+} ;
+
+/**
+ * @brief A fixed-capacity lock-free ring buffer for exactly one
+ *        producer and one consumer, parameterized by an index policy
+ *        and an optional compile-time capacity.
+ *
+ *        The producer and consumer each own one index: the producer
+ *        advances the head after publishing data and the consumer
+ *        advances the tail after removing data. Both indices increase
+ *        monotonically and are reduced modulo the buffer capacity only
+ *        when accessing the storage, so a full buffer and an empty
+ *        buffer are always distinguishable. The indices are placed at
+ *        least one cache line apart to avoid false sharing between the
+ *        producer and consumer threads.
+ *
+ *        The IndexPolicy selects the synchronization strength:
+ *        AtomicRingIndexPolicy (the default) supports one producer
+ *        thread and one concurrent consumer thread, while
+ *        SingleThreadedRingIndexPolicy removes the atomics entirely
+ *        for buffers used from a single thread. A non-zero
+ *        StaticCapacity fixes the capacity at compile time, letting
+ *        the compiler fold the index mask into a constant; it must be
+ *        a power of two.
+ *
+ *        With the atomic policy, all producer methods may be called
+ *        concurrently with all consumer methods without any locking.
+ *        Calling two producer methods (or two consumer methods)
+ *        concurrently from different threads is never allowed.
+ *
+ * @note With the atomic policy, every operation in this class is
+ *       async-signal-safe, which allows the producer side to be
+ *       driven from a POSIX signal handler.
+ */
+template< typename     IndexPolicy    = AtomicRingIndexPolicy,
+          std::size_t  StaticCapacity = 0 >
+class BasicSPSCRingBuffer
+{
+    static_assert( ( 0 == StaticCapacity ) ||
+                   ( 0 == ( StaticCapacity & ( StaticCapacity - 1 ) ) ),
+                   "StaticCapacity must be zero or a power of two." ) ;
+public:
+    /**
+     * @brief Creates a ring buffer that can hold up to the specified
+     *        number of bytes. The capacity is rounded up to the next
+     *        power of two so that index arithmetic reduces to a bit
+     *        mask. When StaticCapacity is non-zero the capacity is
+     *        fixed at compile time and the parameter is ignored.
+     */
+    explicit BasicSPSCRingBuffer( std::size_t capacity = StaticCapacity ) :
+        mBuffer(0),
+        mCapacity( StaticCapacity ? StaticCapacity
+                                  : RoundUpToPowerOfTwo(capacity) ),
+        mHead(),
+        mTail()
+    {
+        IndexPolicy::StoreRelease( mHead, 0 ) ;
+        IndexPolicy::StoreRelease( mTail, 0 ) ;
+        mBuffer = new unsigned char[ this->GetCapacity() ] ;
+    }
+
+    ~BasicSPSCRingBuffer()
+    {
+        delete [] mBuffer ;
+    }
+
+    /**
+     * @brief Returns the maximum number of bytes the buffer can hold.
+     *        A compile-time constant when StaticCapacity is non-zero.
+     */
+    std::size_t
+    GetCapacity() const
+    {
+        return StaticCapacity ? StaticCapacity : mCapacity ;
+    }
+
+    /**
+     * @brief Returns the total number of bytes ever stored into the
+     *        buffer. Together with GetTotalReadCount() this provides
+     *        a monotonically increasing stream offset for the data
+     *        passing through the buffer.
+     */
+    std::size_t
+    GetTotalWriteCount() const
+    {
+        return IndexPolicy::LoadAcquire( mHead ) ;
+    }
+
+    /**
+     * @brief Returns the total number of bytes ever removed from the
+     *        buffer.
+     */
+    std::size_t
+    GetTotalReadCount() const
+    {
+        return IndexPolicy::LoadAcquire( mTail ) ;
+    }
+
+    /**
+     * @brief Returns the number of bytes currently stored in the
+     *        buffer. This value may be stale by the time it is used but
+     *        it is always a lower bound when called by the consumer and
+     *        an upper bound when called by the producer.
+     */
+    std::size_t
+    GetSize() const
+    {
+        return ( IndexPolicy::LoadAcquire( mHead ) -
+                 IndexPolicy::LoadAcquire( mTail ) ) ;
+    }
+
+    /**
+     * @brief Returns true iff the buffer contains no data.
+     */
+    bool
+    IsEmpty() const
+    {
+        return ( 0 == this->GetSize() ) ;
+    }
+
+    /**
+     * @brief Copies up to count bytes from data into the buffer.
+     *        Producer side only.
+     *
+     * @return Returns the number of bytes actually stored, which is
+     *         less than count if the buffer did not have enough free
+     *         space.
+     */
+    std::size_t
+    Write( const unsigned char* data,
+           std::size_t          count )
+    {
+        const std::size_t head = IndexPolicy::LoadRelaxed( mHead ) ;
+        const std::size_t tail = IndexPolicy::LoadAcquire( mTail ) ;
+        const std::size_t free_space = this->GetCapacity() - ( head - tail ) ;
+        if ( count > free_space )
+        {
+            count = free_space ;
+        }
+        if ( 0 == count )
+        {
+            return 0 ;
+        }
+        //
+        // The copy may wrap around the end of the storage, in which
+        // case it is split into two memcpy calls.
+        //
+        const std::size_t head_index = head & ( this->GetCapacity() - 1 ) ;
+        const std::size_t bytes_till_end = this->GetCapacity() - head_index ;
+        if ( count <= bytes_till_end )
+        {
+            std::memcpy( mBuffer + head_index, data, count ) ;
+        }
+        else
+        {
+            std::memcpy( mBuffer + head_index, data, bytes_till_end ) ;
+            std::memcpy( mBuffer, data + bytes_till_end, count - bytes_till_end ) ;
+        }
+        //
+        // Publish the data to the consumer.
+        //
+        IndexPolicy::StoreRelease( mHead,
+                                   head + count ) ;
+        return count ;
+    }
+
+    /**
+     * @brief Stores a single byte in the buffer. Producer side only.
+     *
+     * @return Returns true on success and false if the buffer is full.
+     */
+    bool
+    PushByte( const unsigned char dataByte )
+    {
+        return ( 1 == this->Write( &dataByte, 1 ) ) ;
+    }
+
+    /**
+     * @brief Copies up to count bytes from the buffer into data and
+     *        removes them from the buffer. Consumer side only.
+     *
+     * @return Returns the number of bytes actually copied, which is
+     *         less than count if the buffer did not contain enough
+     *         data.
+     */
+    std::size_t
+    Read( unsigned char* data,
+          std::size_t    count )
+    {
+        const std::size_t tail = IndexPolicy::LoadRelaxed( mTail ) ;
+        const std::size_t head = IndexPolicy::LoadAcquire( mHead ) ;
+        const std::size_t available = head - tail ;
+        if ( count > available )
+        {
+            count = available ;
+        }
+        if ( 0 == count )
+        {
+            return 0 ;
+        }
+        const std::size_t tail_index = tail & ( this->GetCapacity() - 1 ) ;
+        const std::size_t bytes_till_end = this->GetCapacity() - tail_index ;
+        if ( count <= bytes_till_end )
+        {
+            std::memcpy( data, mBuffer + tail_index, count ) ;
+        }
+        else
+        {
+            std::memcpy( data, mBuffer + tail_index, bytes_till_end ) ;
+            std::memcpy( data + bytes_till_end, mBuffer, count - bytes_till_end ) ;
+        }
+        //
+        // Release the space back to the producer.
+        //
+        IndexPolicy::StoreRelease( mTail,
+                                   tail + count ) ;
+        return count ;
+    }
+
+    /**
+     * @brief Removes a single byte from the buffer and returns it
+     *        through dataByte. Consumer side only.
+     *
+     * @return Returns true on success and false if the buffer is empty.
+     */
+    bool
+    PopByte( unsigned char& dataByte )
+    {
+        return ( 1 == this->Read( &dataByte, 1 ) ) ;
+    }
+
+    /**
+     * @brief Copies up to count bytes from the buffer into data
+     *        without removing them. Use Consume() to remove bytes
+     *        once they have actually been processed; this allows a
+     *        consumer to hand data to an operation that may only
+     *        partially succeed (such as a non-blocking write) without
+     *        losing the unprocessed remainder. Consumer side only.
+     *
+     * @return Returns the number of bytes actually copied.
+     */
+    std::size_t
+    Peek( unsigned char* data,
+          std::size_t    count ) const
+    {
+        const std::size_t tail = IndexPolicy::LoadRelaxed( mTail ) ;
+        const std::size_t head = IndexPolicy::LoadAcquire( mHead ) ;
+        const std::size_t available = head - tail ;
+        if ( count > available )
+        {
+            count = available ;
+        }
+        if ( 0 == count )
+        {
+            return 0 ;
+        }
+        const std::size_t tail_index = tail & ( this->GetCapacity() - 1 ) ;
+        const std::size_t bytes_till_end = this->GetCapacity() - tail_index ;
+        if ( count <= bytes_till_end )
+        {
+            std::memcpy( data, mBuffer + tail_index, count ) ;
+        }
+        else
+        {
+            std::memcpy( data, mBuffer + tail_index, bytes_till_end ) ;
+            std::memcpy( data + bytes_till_end, mBuffer, count - bytes_till_end ) ;
+        }
+        return count ;
+    }
+
+    /**
+     * @brief Searches the buffered data for the first occurrence of
+     *        the specified byte using memchr on the (at most two)
+     *        contiguous segments of the buffer. Consumer side only.
+     *
+     * @param dataByte The byte value to search for.
+     * @param position On success, set to the offset of the byte from
+     *        the front of the buffer.
+     * @return Returns true iff the byte was found.
+     */
+    bool
+    FindByte( const unsigned char dataByte,
+              std::size_t&        position ) const
+    {
+        const std::size_t tail = IndexPolicy::LoadRelaxed( mTail ) ;
+        const std::size_t head = IndexPolicy::LoadAcquire( mHead ) ;
+        const std::size_t available = head - tail ;
+        if ( 0 == available )
+        {
+            return false ;
+        }
+        const std::size_t tail_index = tail & ( this->GetCapacity() - 1 ) ;
+        std::size_t first_segment_size = this->GetCapacity() - tail_index ;
+        if ( first_segment_size > available )
+        {
+            first_segment_size = available ;
+        }
+        const void* match = std::memchr( mBuffer + tail_index,
+                                         dataByte,
+                                         first_segment_size ) ;
+        if ( 0 != match )
+        {
+            position = static_cast<const unsigned char*>(match) -
+                       ( mBuffer + tail_index ) ;
+            return true ;
+        }
+        if ( available > first_segment_size )
+        {
+            match = std::memchr( mBuffer,
+                                 dataByte,
+                                 available - first_segment_size ) ;
+            if ( 0 != match )
+            {
+                position = first_segment_size +
+                           ( static_cast<const unsigned char*>(match) - mBuffer ) ;
+                return true ;
+            }
+        }
+        return false ;
+    }
+
+    /**
+     * @brief Removes up to count bytes from the front of the buffer
+     *        without copying them anywhere. Consumer side only.
+     *
+     * @return Returns the number of bytes actually removed.
+     */
+    std::size_t
+    Consume( std::size_t count )
+    {
+        const std::size_t tail = IndexPolicy::LoadRelaxed( mTail ) ;
+        const std::size_t head = IndexPolicy::LoadAcquire( mHead ) ;
+        const std::size_t available = head - tail ;
+        if ( count > available )
+        {
+            count = available ;
+        }
+        IndexPolicy::StoreRelease( mTail,
+                                   tail + count ) ;
+        return count ;
+    }
+
+    /**
+     * @brief Discards all data currently stored in the buffer.
+     *        Consumer side only.
+     */
+    void
+    Clear()
+    {
+        IndexPolicy::StoreRelease( mTail,
+                                   IndexPolicy::LoadAcquire( mHead ) ) ;
+    }
+
+private:
+    /**
+     * @brief Returns the smallest power of two that is greater than or
+     *        equal to the specified value.
+     */
+    static std::size_t
+    RoundUpToPowerOfTwo( std::size_t value )
+    {
+        std::size_t result = 1 ;
+        while( result < value )
+        {
+            result <<= 1 ;
+        }
+        return result ;
+    }
+
+    /**
+     * The copy constructor and the assignment operator are declared
+     * private but never defined. This allows the compiler to catch
+     * attempts to copy instances of this class.
+     */
+    BasicSPSCRingBuffer( const BasicSPSCRingBuffer& ) ;
+    BasicSPSCRingBuffer& operator=( const BasicSPSCRingBuffer& ) ;
+
+    /**
+     * Storage for the buffered data. The size of this array is always
+     * a power of two.
+     */
+    unsigned char* mBuffer ;
+
+    /**
+     * Capacity of mBuffer in bytes. Unused (the compile-time constant
+     * takes precedence) when StaticCapacity is non-zero.
+     */
+    const std::size_t mCapacity ;
+
+    /**
+     * Index at which the producer stores the next byte. The padding
+     * that follows keeps the head and tail indices at least one cache
+     * line apart, so that producer writes do not invalidate the cache
+     * line holding the tail on the consumer's CPU (and vice versa).
+     * Explicit padding is used instead of alignas(64) because
+     * operator new is not required to honor extended alignment until
+     * C++17.
+     */
+    typename IndexPolicy::Index mHead ;
+    char mHeadTailPadding[ 64 - sizeof(typename IndexPolicy::Index) ] ;
+
+    /**
+     * Index from which the consumer removes the next byte.
+     */
+    typename IndexPolicy::Index mTail ;
+} ;
+
+/**
+ * @brief The default ring buffer used on the serial port I/O paths:
+ *        atomic indices (one producer thread, one consumer thread)
+ *        and run-time capacity.
+ */
+typedef BasicSPSCRingBuffer<> SPSCRingBuffer ;
+
+#endif // #ifndef _SPSCRingBuffer_h_
@@ -20,22 +20,63 @@
  *****************************************************************************/
 
 #include "SerialPort.h"
-#include "PosixSignalDispatcher.h"
-#include "PosixSignalHandler.h"
+#include "EpollEventEngine.h"
+#include "EpollEventHandler.h"
+#include "SPSCRingBuffer.h"
 
+#include <atomic>
 #include <cstring>
+#include <deque>
+#include <pthread.h>
 #include <iostream>
 #include <fcntl.h>
-#include <queue>
-#include <signal.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+#include <poll.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <system_error>
+#include <stdint.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <math.h>
 #include <cerrno>
 
+#ifdef __linux__
+//
+// Definitions needed to set arbitrary baud rates with the TCGETS2 and
+// TCSETS2 ioctls. <asm/termbits.h> provides these but cannot be
+// included alongside <termios.h> (both define struct termios), so the
+// termios2 structure is declared here to match the layout in the
+// kernel's include/uapi/asm-generic/termbits.h.
+//
+#ifndef BOTHER
+#define BOTHER 0010000
+#endif
+#ifndef CBAUD
+#define CBAUD 0010017
+#endif
+struct termios2
+{
+    tcflag_t c_iflag ;
+    tcflag_t c_oflag ;
+    tcflag_t c_cflag ;
+    tcflag_t c_lflag ;
+    cc_t     c_line ;
+    cc_t     c_cc[19] ;
+    speed_t  c_ispeed ;
+    speed_t  c_ospeed ;
+} ;
+#endif /* __linux__ */
+
 
 namespace
 {
@@ -50,20 +91,76 @@ namespace
     const std::string ERR_MSG_INVALID_PARITY       = "Invalid parity setting." ;
     const std::string ERR_MSG_INVALID_STOP_BITS    = "Invalid number of stop bits." ;
     const std::string ERR_MSG_INVALID_FLOW_CONTROL = "Invalid flow control." ;
+    const std::string ERR_MSG_INVALID_LATENCY_MODE = "Invalid latency mode." ;
+    const std::string ERR_MSG_NO_FRAMING_MODE      = "No framing mode configured." ;
+    const std::string ERR_MSG_INVALID_FRAME_LENGTH = "Invalid frame length." ;
+    const std::string ERR_MSG_INVALID_PREFIX_LENGTH = "Invalid length prefix size." ;
+
+    /*
+     * Return the absolute CLOCK_REALTIME deadline that lies msTimeout
+     * milliseconds in the future, in the format expected by
+     * sem_timedwait().
+     */
+    struct timespec
+    ComputeDeadline( const unsigned int msTimeout ) ;
+
+    /*
+     * Capacity (in bytes) of the ring buffer used to store data
+     * received at the serial port until it is read by the user.
+     */
+    const std::size_t RX_BUFFER_CAPACITY = 65536 ;
+
+    /*
+     * Size (in bytes) of the chunk used to drain the tty input buffer
+     * with bulk read() calls when the port signals available data.
+     */
+    const std::size_t RX_READ_CHUNK_SIZE = 4096 ;
+
+    /*
+     * Capacity (in bytes) of the ring buffer used to store data
+     * queued for asynchronous transmission.
+     */
+    const std::size_t TX_BUFFER_CAPACITY = 65536 ;
+
+    /*
+     * Size (in bytes) of the chunk used to drain the asynchronous
+     * write queue with bulk write() calls when the port becomes
+     * writable.
+     */
+    const std::size_t TX_WRITE_CHUNK_SIZE = 4096 ;
+
+    /*
+     * Number of entries in the ring recording the arrival time of
+     * received chunks when timestamping is enabled. Must be a power
+     * of two.
+     */
+    const std::size_t RX_TIMESTAMP_RING_CAPACITY = 1024 ;
+
+    /*
+     * Layout of a capture file: one page of header followed by a data
+     * region used as a byte ring holding length- and time-prefixed
+     * chunk records.
+     */
+    const char        CAPTURE_FILE_MAGIC[8] = { 'L','S','C','A','P','0','1','\0' } ;
+    const std::size_t CAPTURE_HEADER_SIZE   = 4096 ;
+
+    struct CaptureFileHeader
+    {
+        char     magic[8] ;
+        uint64_t dataCapacity ;
+        uint64_t headOffset ;   // total bytes ever appended
+        uint64_t tailOffset ;   // total bytes of evicted records
+    } ;
 
     /*
-     * Return the difference between the two specified timeval values.
-     * This method subtracts secondOperand from firstOperand and returns
-     * the result as a timeval. The time represented by firstOperand must
-     * be later than the time represented by secondOperand. Otherwise,
-     * the result of this operator may be undefined.
+     * Size of the header prefixed to each captured chunk: a 32-bit
+     * payload length, 64-bit seconds, and 32-bit nanoseconds of the
+     * CLOCK_MONOTONIC arrival time.
      */
-    const struct timeval
-    operator-( const struct timeval& firstOperand,
-               const struct timeval& secondOperand ) ;
+    const std::size_t CAPTURE_RECORD_HEADER_SIZE = 16 ;
 }
 
-class SerialPort::SerialPortImpl : public PosixSignalHandler
+class SerialPort::SerialPortImpl : public EpollEventHandler
 {
 public:
     /**
@@ -79,9 +176,7 @@ public:
     /**
      * Open the serial port.
      */
-    void Open()
-        throw( SerialPort::OpenFailed,
-               SerialPort::AlreadyOpen ) ;
+    void Open() ;
 
     /**
      * Check if the serial port is currently open.
@@ -93,150 +188,247 @@ public:
      * Close the serial port.
      */
     void
-    Close()
-        throw(SerialPort::NotOpen) ;
+    Close() ;
+
+    /**
+     * Apply a complete set of communication parameters with a single
+     * tcgetattr/tcsetattr round trip.
+     */
+    void
+    ApplySettings( const SerialPort::Settings& settings ) ;
 
     /**
      * Set the baud rate of the serial port.
      */
     void
-    SetBaudRate( const SerialPort::BaudRate baudRate )
-        throw( SerialPort::NotOpen,
-               SerialPort::UnsupportedBaudRate,
-               std::invalid_argument,
-               std::runtime_error ) ;
+    SetBaudRate( const SerialPort::BaudRate baudRate ) ;
 
     /**
      * Get the current baud rate.
      */
     SerialPort::BaudRate
-    GetBaudRate() const
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    GetBaudRate() const ;
+
+    /**
+     * Set an arbitrary baud rate using the termios2 interface.
+     */
+    void
+    SetCustomBaudRate( const unsigned int baudRate ) ;
+
+    /**
+     * Get the currently configured baud rate in bits per second.
+     */
+    unsigned int
+    GetCustomBaudRate() const ;
 
     /**
      * Set the character size.
      */
     void
-    SetCharSize( const SerialPort::CharacterSize charSize )
-        throw( SerialPort::NotOpen,
-               std::invalid_argument,
-               std::runtime_error ) ;
+    SetCharSize( const SerialPort::CharacterSize charSize ) ;
 
     /**
      * Get the current character size.
      */
     SerialPort::CharacterSize
-    GetCharSize() const
-        throw( SerialPort::NotOpen,
-               std::runtime_error )  ;
+    GetCharSize() const ;
 
     void
-    SetParity( const SerialPort::Parity parityType )
-        throw( SerialPort::NotOpen,
-               std::invalid_argument,
-               std::runtime_error )  ;
+    SetParity( const SerialPort::Parity parityType ) ;
 
     SerialPort::Parity
-    GetParity() const
-        throw(SerialPort::NotOpen) ;
+    GetParity() const ;
 
     void
-    SetNumOfStopBits( const SerialPort::StopBits numOfStopBits )
-        throw( SerialPort::NotOpen,
-               std::invalid_argument )  ;
+    SetNumOfStopBits( const SerialPort::StopBits numOfStopBits ) ;
 
     SerialPort::StopBits
-    GetNumOfStopBits() const
-        throw(SerialPort::NotOpen) ;
+    GetNumOfStopBits() const ;
 
     void
-    SetFlowControl( const SerialPort::FlowControl flowControl )
-        throw( SerialPort::NotOpen,
-               std::invalid_argument ) ;
+    SetFlowControl( const SerialPort::FlowControl flowControl ) ;
 
     SerialPort::FlowControl
-    GetFlowControl() const
-        throw( SerialPort::NotOpen ) ;
+    GetFlowControl() const ;
+
+    void
+    SetLatencyMode( const SerialPort::LatencyMode latencyMode ) ;
+
+    SerialPort::LatencyMode
+    GetLatencyMode() const ;
+
+    SerialPort::Statistics
+    GetStatistics() const ;
+
+    void
+    ResetStatistics() ;
+
+    void
+    EnableReadLatencyHistogram( const bool enabled ) ;
 
     bool
-    IsDataAvailable() const
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    IsDataAvailable() const ;
+
+    std::size_t
+    GetAvailableByteCount() const ;
+
+    void
+    SetDataEventSemaphore( sem_t* dataEventSemaphore ) ;
+
+    void
+    EnableDedicatedReaderThread( const int cpuAffinity,
+                                 const int realtimePriority ) ;
 
     unsigned char
-    ReadByte(const unsigned int msTimeout = 0 )
-        throw( SerialPort::NotOpen,
-               SerialPort::ReadTimeout,
-               std::runtime_error ) ;
+    ReadByte(const unsigned int msTimeout = 0 ) ;
+
+    bool
+    TryReadByte( unsigned char&     dataByte,
+                 const unsigned int msTimeout ) noexcept ;
+
+    std::error_code
+    TryRead( unsigned char*     dataBuffer,
+             const unsigned int numOfBytes,
+             const unsigned int msTimeout,
+             std::size_t&       numOfBytesRead ) noexcept ;
+
+    std::error_code
+    TryWrite( const unsigned char* dataBuffer,
+              const unsigned int   bufferSize ) noexcept ;
 
     void
     Read( SerialPort::DataBuffer& dataBuffer,
           const unsigned int      numOfBytes,
-          const unsigned int      msTimeout )
-        throw( SerialPort::NotOpen,
-               SerialPort::ReadTimeout,
-               std::runtime_error  ) ;
+          const unsigned int      msTimeout ) ;
+
+    void
+    Read( unsigned char*     dataBuffer,
+          const unsigned int numOfBytes,
+          const unsigned int msTimeout ) ;
+
+    void
+    Read( unsigned char*               dataBuffer,
+          const unsigned int           numOfBytes,
+          const unsigned int           msTimeout,
+          SerialPort::RxTimestampList& timestamps ) ;
+
+    std::size_t
+    ReadWithDeadline( unsigned char*     dataBuffer,
+                      const std::size_t  maxNumOfBytes,
+                      const unsigned int msTimeout ) ;
+
+    void
+    ConfigureDelimiterFraming( const unsigned char delimiter ) ;
+
+    void
+    ConfigureFixedLengthFraming( const std::size_t frameLength ) ;
+
+    void
+    ConfigureLengthPrefixFraming( const std::size_t prefixLength,
+                                  const bool        bigEndian ) ;
+
+    void
+    DisableFraming() ;
+
+    void
+    ReadFrame( SerialPort::DataBuffer& frameBuffer,
+               const unsigned int      msTimeout ) ;
+
+    void
+    EnableRxTimestamping( const bool enabled ) ;
+
+    void
+    StartCapture( const std::string& captureFilePath,
+                  const std::size_t  maxFileSize ) ;
+
+    void
+    StopCapture() ;
 
-    const std::string
+    std::string
     ReadLine( const unsigned int msTimeout = 0,
-              const char         lineTerminator = '\n' )
-        throw( SerialPort::NotOpen,
-               SerialPort::ReadTimeout,
-               std::runtime_error ) ;
+              const char         lineTerminator = '\n' ) ;
+
+    void
+    ReadLine( std::string&       line,
+              const unsigned int msTimeout,
+              const char         lineTerminator ) ;
+
+    void
+    ReadLineIncremental( std::string&       line,
+                         const unsigned int msTimeout,
+                         const char         lineTerminator ) ;
 
     void
-    WriteByte( const unsigned char dataByte )
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    WriteByte( const unsigned char dataByte ) ;
 
     void
-    Write(const SerialPort::DataBuffer& dataBuffer)
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    Write(const SerialPort::DataBuffer& dataBuffer) ;
 
     void
     Write( const unsigned char* dataBuffer,
-           const unsigned int   bufferSize )
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+           const unsigned int   bufferSize ) ;
+
+    void
+    WriteGather( const SerialPort::GatherBuffer& gatherBuffer ) ;
+
+    unsigned int
+    WriteAsync( const unsigned char* dataBuffer,
+                const unsigned int   bufferSize ) ;
+
+    void
+    ReadAsync( const std::size_t       numOfBytes,
+               SerialPort::ReadCallback callback ) ;
+
+    unsigned int
+    WriteAsync( const unsigned char*      dataBuffer,
+                const unsigned int        bufferSize,
+                SerialPort::WriteCallback callback ) ;
+
+    std::size_t
+    GetAsyncWriteQueueSize() const ;
+
+    void
+    WaitForAsyncWrites( const unsigned int msTimeout ) ;
+
+    std::size_t
+    GetOutputQueueByteCount() const ;
+
+    void
+    DrainWriteBuffer( const unsigned int msTimeout ) ;
 
     void
-    SetDtr( const bool dtrState )
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    SetDtr( const bool dtrState ) ;
     
     bool
-    GetDtr() const 
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    GetDtr() const ;
 
     void
-    SetRts( const bool rtsState )
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    SetRts( const bool rtsState ) ;
     
     bool
-    GetRts() const 
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    GetRts() const ;
 
     bool
-    GetCts() const 
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    GetCts() const ;
 
     
     bool
-    GetDsr() const 
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+    GetDsr() const ;
     /*
      * This method must be defined by all subclasses of
-     * PosixSignalHandler.
+     * EpollEventHandler. It is called from the event loop of the
+     * EpollEventEngine whenever data is available at the serial port.
+     */
+    void
+    HandleReadEvent() ;
+
+    /*
+     * This method is called from the event loop of the
+     * EpollEventEngine whenever the serial port can accept more data
+     * for transmission while asynchronous writes are queued.
      */
     void
-    HandlePosixSignal(int signalNumber) ;
+    HandleWriteEvent() ;
 private:
     /**
      * Name of the serial port. On POSIX systems this is the name of
@@ -254,6 +446,20 @@ private:
      */
     int mFileDescriptor ;
 
+    /**
+     * The latency tuning mode currently selected for the port.
+     */
+    SerialPort::LatencyMode mLatencyMode ;
+
+    /**
+     * Framing configuration used by ReadFrame().
+     */
+    SerialPort::FramingMode mFramingMode ;
+    unsigned char           mFrameDelimiter ;
+    std::size_t             mFrameLength ;
+    std::size_t             mFramePrefixLength ;
+    bool                    mFramePrefixBigEndian ;
+
     /**
      * Serial port settings are saved into this variable immediately
      * after the port is opened. These settings are restored when the
@@ -262,38 +468,284 @@ private:
     termios mOldPortSettings ;
 
     /**
-     * Circular buffer used to store the received data. This is done
-     * asynchronously and helps prevent overflow of the corresponding 
-     * tty's input buffer.
-     * 
-     * :TODO: The size of this buffer is allowed to increase indefinitely. If 
-     * data keeps arriving at the serial port and is never read then this 
-     * buffer will continue occupying more and more memory. We need to put a 
-     * cap on the size of this buffer. It might even be worth providing a 
-     * method to set the size of this buffer.  
+     * Lock-free single-producer/single-consumer ring buffer used to
+     * store the received data. The signal handler is the only producer
+     * and the reading thread (ReadByte and friends) is the only
+     * consumer, so no locking is needed on the data path. If the
+     * buffer fills up, further data is left in the tty's input buffer
+     * so that the kernel can apply flow control.
+     */
+    SPSCRingBuffer mInputBuffer ;
+
+    /*
+     * Counting semaphore posted by HandlePosixSignal whenever data is
+     * added to mInputBuffer. ReadByte waits on this semaphore instead
+     * of polling the buffer so that it wakes up as soon as data
+     * arrives. A semaphore is used here rather than a condition
+     * variable because sem_post is async-signal-safe and a semaphore
+     * cannot miss a wakeup posted before the consumer starts waiting.
+     */
+    sem_t mDataAvailableSemaphore;
+
+    /*
+     * True when delivery of read events for this port has been paused
+     * because mInputBuffer was full. The read methods resume event
+     * delivery once they have made space in the buffer.
+     */
+    std::atomic<bool> mRxEventsPaused;
+
+    /**
+     * Lock-free single-producer/single-consumer ring buffer used to
+     * store data queued for asynchronous transmission. The thread
+     * calling WriteAsync is the only producer and the event loop
+     * (HandleWriteEvent) is the only consumer.
+     */
+    SPSCRingBuffer mOutputBuffer ;
+
+    /*
+     * Counting semaphore posted by HandleWriteEvent whenever the
+     * asynchronous write queue becomes empty. WaitForAsyncWrites
+     * blocks on this semaphore.
+     */
+    sem_t mTxDrainedSemaphore;
+
+    /*
+     * Optional semaphore registered by a SerialPortGroup; posted in
+     * addition to mDataAvailableSemaphore whenever data is stored
+     * into the input buffer.
+     */
+    std::atomic<sem_t*> mDataEventSemaphore;
+
+    /*
+     * One entry per received chunk when timestamping is enabled. The
+     * stream offsets refer to the monotonically increasing byte
+     * counters of mInputBuffer.
+     */
+    struct RxChunkInfo
+    {
+        std::size_t     startOffset ;
+        std::size_t     length ;
+        struct timespec arrivalTime ;
+    } ;
+
+    /*
+     * Preallocated ring of chunk arrival records, with the event loop
+     * as the only producer and the read methods as the only consumer.
+     * Allocated the first time timestamping is enabled. If the ring
+     * fills up (the reader lags by more than
+     * RX_TIMESTAMP_RING_CAPACITY chunks), records for further chunks
+     * are dropped while the data itself is still delivered.
+     */
+    RxChunkInfo* mRxChunkRing ;
+    std::atomic<std::size_t> mRxChunkHead ;
+    std::atomic<std::size_t> mRxChunkTail ;
+
+    /*
+     * True while per-chunk arrival timestamps are being recorded.
+     */
+    std::atomic<bool> mRxTimestampsEnabled;
+
+    /*
+     * State of the optional mmap-backed capture of raw received
+     * traffic. The mutex serializes chunk appends (producer side)
+     * against StartCapture/StopCapture so the mapping cannot vanish
+     * under an append.
+     */
+    std::atomic<bool>  mCaptureEnabled;
+    int                mCaptureFileDescriptor;
+    void*              mCaptureMapping;
+    std::size_t        mCaptureMappingSize;
+    CaptureFileHeader* mCaptureHeader;
+    unsigned char*     mCaptureData;
+    pthread_mutex_t    mCaptureMutex;
+
+    /**
+     * Append one received chunk (with its arrival time) to the
+     * capture ring file, evicting the oldest records when the data
+     * region is full.
+     */
+    void
+    CaptureChunk( const unsigned char*   data,
+                  const std::size_t      numOfBytes,
+                  const struct timespec& arrivalTime ) ;
+
+    /**
+     * Copy bytes into the capture data region at the given monotonic
+     * offset, wrapping at the region capacity.
+     */
+    void
+    CaptureWriteBytes( const uint64_t       offset,
+                       const unsigned char* data,
+                       const std::size_t    numOfBytes ) ;
+
+    /*
+     * State of the optional dedicated reader thread: true while the
+     * thread is running, the thread handle, and the self-pipe used to
+     * interrupt its blocking poll() when the port is closed. While
+     * the thread is active, read events from the event engine are
+     * disabled for the port and the thread is the sole producer of
+     * mInputBuffer.
+     */
+    std::atomic<bool> mReaderThreadActive;
+    pthread_t mReaderThread;
+    int mReaderShutdownPipe[2];
+
+    /**
+     * Main loop of the dedicated reader thread.
+     */
+    static void*
+    ReaderThreadFunc( void* serialPortImpl ) ;
+
+    /*
+     * Instrumentation counters, maintained with relaxed atomic
+     * increments on the I/O paths. See SerialPort::Statistics for the
+     * meaning of the individual counters.
+     */
+    std::atomic<unsigned long long> mStatBytesReceived;
+    std::atomic<unsigned long long> mStatBytesTransmitted;
+    std::atomic<unsigned long long> mStatReadSyscalls;
+    std::atomic<unsigned long long> mStatWriteSyscalls;
+    std::atomic<unsigned long long> mStatReadTimeouts;
+    std::atomic<unsigned long long> mStatWriteTimeouts;
+    std::atomic<unsigned long long> mStatRxPauseEvents;
+    std::atomic<std::size_t>        mStatRxHighWatermark;
+
+    /*
+     * Histogram of wait-for-data durations, populated only while
+     * mLatencyHistogramEnabled is set.
+     */
+    std::atomic<bool> mLatencyHistogramEnabled;
+    std::atomic<unsigned long long> mStatReadLatencyHistogram[SerialPort::READ_LATENCY_NUM_BUCKETS];
+
+    /**
+     * Collect the timestamp records overlapping the consumed stream
+     * range [rangeStart, rangeEnd) into the specified list, with
+     * offsets rebased to rangeStart. Fully consumed records are
+     * removed from the ring.
+     */
+    void
+    CollectRxTimestamps( const std::size_t            rangeStart,
+                         const std::size_t            rangeEnd,
+                         SerialPort::RxTimestampList& timestamps ) ;
+
+    /*
+     * True while write events are enabled for the port, i.e. while
+     * data is queued in mOutputBuffer waiting to be transmitted.
+     */
+    std::atomic<bool> mTxEventsEnabled;
+
+    /*
+     * Mutex serializing updates of the epoll event mask for the port
+     * so that the last applied mask always reflects the latest state
+     * of mRxEventsPaused and mTxEventsEnabled.
      */
-    std::queue<unsigned char> mInputBuffer ;
+    pthread_mutex_t mEventMaskMutex;
 
     /*
-     * In order to be thread save, a second queue is implemented to store
-     * byte which are received while the queue is locked by the
-     * ReadByte method. The content must be transfered to mInputBuffer
-     * before further bytes are stored into it.
+     * An asynchronous read request issued with ReadAsync and not yet
+     * completed.
      */
-    std::queue<unsigned char> mShadowInputBuffer ;
+    struct PendingAsyncRead
+    {
+        std::size_t              numOfBytes ;
+        SerialPort::ReadCallback callback ;
+    } ;
+
+    /*
+     * An asynchronous write completion registered with WriteAsync and
+     * not yet delivered. completionOffset is the value the output
+     * buffer's total read count must reach for the queued bytes to
+     * have been handed to the kernel.
+     */
+    struct PendingAsyncWrite
+    {
+        std::size_t               completionOffset ;
+        SerialPort::WriteCallback callback ;
+    } ;
 
     /*
-     * Mutex to control threaded access to mInputBuffer
+     * Outstanding asynchronous requests, in issue order, and the
+     * mutex protecting them. The mutex also serializes the
+     * consumer-side ring buffer accesses made while completing read
+     * requests.
      */
-    pthread_mutex_t mQueueMutex;
+    std::deque<PendingAsyncRead>  mPendingReads;
+    std::deque<PendingAsyncWrite> mPendingWrites;
+    pthread_mutex_t mAsyncRequestMutex;
 
     /*
-     * Indicates if unread bytes are available within the queue
+     * Held across completion callback invocations so that
+     * completions are delivered strictly in issue order even when the
+     * event loop and a thread calling ReadAsync/WriteAsync race to
+     * service the queues. Only ever acquired with trylock; a failed
+     * acquisition means another delivery loop is running (or this is
+     * a nested call from inside a callback) and will pick the work
+     * up.
+     */
+    pthread_mutex_t mCompletionDeliveryMutex;
+
+    /**
+     * Complete all pending read requests that can be satisfied from
+     * the input buffer, invoking their callbacks.
+     */
+    void
+    ServicePendingReads() ;
+
+    /**
+     * Deliver all pending write completions whose data has been
+     * handed to the kernel.
+     */
+    void
+    ServicePendingWrites() ;
+
+    /**
+     * Apply the current values of mRxEventsPaused and mTxEventsEnabled
+     * to the event mask of the port.
+     */
+    void
+    UpdateHandlerEvents() ;
+
+    /**
+     * Re-enable delivery of read events for the port if it was paused
+     * because the input buffer was full and space is available again.
+     */
+    void
+    ResumeReadEventsIfNeeded() ;
+
+    /**
+     * Block until at least one byte is available in mInputBuffer. If
+     * msTimeout is non-zero and no data arrives within msTimeout
+     * milliseconds, a ReadTimeout exception is thrown.
+     */
+    void
+    WaitForData( const unsigned int msTimeout ) ;
+
+    /**
+     * Non-throwing core of WaitForData. Returns 0 once data is
+     * available in mInputBuffer and an errno value (most commonly
+     * ETIMEDOUT) otherwise.
+     */
+    int
+    WaitForDataTimed( const unsigned int msTimeout ) noexcept ;
+
+    /**
+     * Like WaitForDataTimed, but waits until mInputBuffer holds more
+     * than previousSize bytes. Used by callers (such as ReadFrame)
+     * that already see buffered data but need more of it.
+     */
+    int
+    WaitForMoreDataTimed( const std::size_t  previousSize,
+                          const unsigned int msTimeout ) noexcept ;
+
+    /**
+     * Add the time elapsed since waitStart to the read-latency
+     * histogram.
      */
-    volatile bool mIsQueueDataAvailable;
+    void
+    RecordWaitLatency( const struct timespec& waitStart ) noexcept ;
 
     /**
-     * Set the specified modem control line to the specified value. 
+     * Set the specified modem control line to the specified value.
      *
      * @param modemLine One of the following four values: TIOCM_DTR,
      * TIOCM_RTS, TIOCM_CTS, or TIOCM_DSR.
@@ -303,9 +755,7 @@ private:
      */
     void
     SetModemControlLine( const int modemLine,
-                         const bool lineState )
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;
+                         const bool lineState ) ;
 
     /**
      * Get the current state of the specified modem control line.
@@ -317,9 +767,7 @@ private:
      * otherwise.
      */
     bool
-    GetModemControlLine( const int modemLine ) const
-        throw( SerialPort::NotOpen,
-               std::runtime_error ) ;        
+    GetModemControlLine( const int modemLine ) const ;        
 } ;
 
 SerialPort::SerialPort( const std::string& serialPortName ) :
@@ -329,7 +777,6 @@ SerialPort::SerialPort( const std::string& serialPortName ) :
 }
 
 SerialPort::~SerialPort()
-    throw()
 {
     /*
      * Close the serial port if it is open.
@@ -354,22 +801,21 @@ SerialPort::Open( const BaudRate      baudRate,
                   const Parity        parityType,
                   const StopBits      stopBits,
                   const FlowControl   flowControl )
-    throw( OpenFailed,
-           AlreadyOpen,
-           UnsupportedBaudRate,
-           std::invalid_argument )
 {
     //
     // Open the serial port.
     mSerialPortImpl->Open() ;
     //
-    // Set the various parameters of the serial port if it is open.
+    // Apply all parameters of the serial port in one transaction
+    // instead of one tcgetattr/tcsetattr round trip per parameter.
     //
-    this->SetBaudRate(baudRate) ;
-    this->SetCharSize(charSize) ;
-    this->SetParity(parityType) ;
-    this->SetNumOfStopBits(stopBits) ;
-    this->SetFlowControl(flowControl) ;
+    Settings settings ;
+    settings.baudRate    = baudRate ;
+    settings.charSize    = charSize ;
+    settings.parityType  = parityType ;
+    settings.stopBits    = stopBits ;
+    settings.flowControl = flowControl ;
+    this->ApplySettings( settings ) ;
 
     //
     // All done.
@@ -377,9 +823,15 @@ SerialPort::Open( const BaudRate      baudRate,
     return ;
 }
 
+void
+SerialPort::ApplySettings( const Settings& settings )
+{
+    mSerialPortImpl->ApplySettings( settings ) ;
+    return ;
+}
+
 void
 SerialPort::Close()
-    throw(NotOpen)
 {
     mSerialPortImpl->Close() ;
     return ;
@@ -393,16 +845,34 @@ SerialPort::IsOpen() const
 
 bool
 SerialPort::IsDataAvailable() const
-    throw(NotOpen)
 {
     return mSerialPortImpl->IsDataAvailable() ;
 }
 
+std::size_t
+SerialPort::GetAvailableByteCount() const
+{
+    return mSerialPortImpl->GetAvailableByteCount() ;
+}
+
+void
+SerialPort::SetDataEventSemaphore( sem_t* dataEventSemaphore )
+{
+    mSerialPortImpl->SetDataEventSemaphore( dataEventSemaphore ) ;
+    return ;
+}
+
+void
+SerialPort::EnableDedicatedReaderThread( const int cpuAffinity,
+                                         const int realtimePriority )
+{
+    mSerialPortImpl->EnableDedicatedReaderThread( cpuAffinity,
+                                                  realtimePriority ) ;
+    return ;
+}
+
 void
 SerialPort::SetBaudRate( const BaudRate baudRate )
-    throw( UnsupportedBaudRate,
-           NotOpen,
-           std::invalid_argument )
 {
     mSerialPortImpl->SetBaudRate( baudRate ) ;
     return ;
@@ -410,31 +880,37 @@ SerialPort::SetBaudRate( const BaudRate baudRate )
 
 SerialPort::BaudRate
 SerialPort::GetBaudRate() const
-    throw( NotOpen,
-           std::runtime_error )
 {
     return mSerialPortImpl->GetBaudRate() ;
 }
 
+void
+SerialPort::SetCustomBaudRate( const unsigned int baudRate )
+{
+    mSerialPortImpl->SetCustomBaudRate( baudRate ) ;
+    return ;
+}
+
+unsigned int
+SerialPort::GetCustomBaudRate() const
+{
+    return mSerialPortImpl->GetCustomBaudRate() ;
+}
+
 void
 SerialPort::SetCharSize( const CharacterSize charSize )
-    throw( NotOpen,
-           std::invalid_argument )
 {
     mSerialPortImpl->SetCharSize(charSize) ;
 }
 
 SerialPort::CharacterSize
 SerialPort::GetCharSize() const
-    throw(NotOpen)
 {
     return mSerialPortImpl->GetCharSize() ;
 }
 
 void
 SerialPort::SetFlowControl( const FlowControl   flowControl )
-    throw( NotOpen,
-           std::invalid_argument )
 {
     mSerialPortImpl->SetFlowControl( flowControl ) ;
     return ;
@@ -442,15 +918,45 @@ SerialPort::SetFlowControl( const FlowControl   flowControl )
 
 SerialPort::FlowControl
 SerialPort::GetFlowControl() const
-    throw( NotOpen )
 {
     return mSerialPortImpl->GetFlowControl() ;
 }
 
+void
+SerialPort::SetLatencyMode( const LatencyMode latencyMode )
+{
+    mSerialPortImpl->SetLatencyMode( latencyMode ) ;
+    return ;
+}
+
+SerialPort::LatencyMode
+SerialPort::GetLatencyMode() const
+{
+    return mSerialPortImpl->GetLatencyMode() ;
+}
+
+SerialPort::Statistics
+SerialPort::GetStatistics() const
+{
+    return mSerialPortImpl->GetStatistics() ;
+}
+
+void
+SerialPort::ResetStatistics()
+{
+    mSerialPortImpl->ResetStatistics() ;
+    return ;
+}
+
+void
+SerialPort::EnableReadLatencyHistogram( const bool enabled )
+{
+    mSerialPortImpl->EnableReadLatencyHistogram( enabled ) ;
+    return ;
+}
+
 void
 SerialPort::SetParity( const Parity parityType )
-    throw( NotOpen,
-           std::invalid_argument )
 {
     mSerialPortImpl->SetParity( parityType ) ;
     return ;
@@ -458,15 +964,12 @@ SerialPort::SetParity( const Parity parityType )
 
 SerialPort::Parity
 SerialPort::GetParity() const
-    throw(NotOpen)
 {
     return mSerialPortImpl->GetParity() ;
 }
 
 void
 SerialPort::SetNumOfStopBits( const StopBits numOfStopBits )
-    throw( NotOpen,
-           std::invalid_argument )
 {
     mSerialPortImpl->SetNumOfStopBits(numOfStopBits) ;
     return ;
@@ -474,15 +977,12 @@ SerialPort::SetNumOfStopBits( const StopBits numOfStopBits )
 
 SerialPort::StopBits
 SerialPort::GetNumOfStopBits() const
-    throw(NotOpen)
 {
     return mSerialPortImpl->GetNumOfStopBits() ;
 }
 
 void
 SerialPort::SetDtr( const bool dtrState )
-    throw( SerialPort::NotOpen,
-           std::runtime_error ) 
 {
     mSerialPortImpl->SetDtr( dtrState ) ;
     return ;
@@ -490,16 +990,12 @@ SerialPort::SetDtr( const bool dtrState )
 
 bool
 SerialPort::GetDtr() const 
-    throw( SerialPort::NotOpen,
-           std::runtime_error ) 
 {
     return mSerialPortImpl->GetDtr() ;
 }
 
 void
 SerialPort::SetRts( const bool rtsState )
-    throw( SerialPort::NotOpen,
-           std::runtime_error ) 
 {
     mSerialPortImpl->SetRts( rtsState ) ;
     return ;
@@ -507,24 +1003,18 @@ SerialPort::SetRts( const bool rtsState )
 
 bool
 SerialPort::GetRts() const 
-    throw( SerialPort::NotOpen,
-           std::runtime_error ) 
 {
     return mSerialPortImpl->GetRts() ;
 }
 
 bool
 SerialPort::GetCts() const 
-    throw( SerialPort::NotOpen,
-           std::runtime_error ) 
 {
     return mSerialPortImpl->GetCts() ;
 }
 
 bool
 SerialPort::GetDsr() const 
-    throw( SerialPort::NotOpen,
-           std::runtime_error ) 
 {
     return mSerialPortImpl->GetDsr() ;
 }
@@ -533,80 +1023,342 @@ void
 SerialPort::Read( SerialPort::DataBuffer& dataBuffer,
                   const unsigned int      numOfBytes,
                   const unsigned int      msTimeout )
-    throw( NotOpen,
-           ReadTimeout,
-           std::runtime_error )
 {
     return mSerialPortImpl->Read( dataBuffer,
                                   numOfBytes,
                                   msTimeout ) ;
 }
 
-unsigned char
-SerialPort::ReadByte( const unsigned int msTimeout )
-    throw( NotOpen,
-           ReadTimeout,
-           std::runtime_error )
+void
+SerialPort::Read( unsigned char*     dataBuffer,
+                  const unsigned int numOfBytes,
+                  const unsigned int msTimeout )
 {
-    return mSerialPortImpl->ReadByte(msTimeout) ;
+    return mSerialPortImpl->Read( dataBuffer,
+                                  numOfBytes,
+                                  msTimeout ) ;
 }
 
-const std::string
-SerialPort::ReadLine( const unsigned int msTimeout,
-                      const char         lineTerminator )
-    throw( NotOpen,
-           ReadTimeout,
-           std::runtime_error )
+void
+SerialPort::Read( unsigned char*     dataBuffer,
+                  const unsigned int numOfBytes,
+                  const unsigned int msTimeout,
+                  RxTimestampList&   timestamps )
 {
-    return mSerialPortImpl->ReadLine( msTimeout,
-                                      lineTerminator ) ;
+    return mSerialPortImpl->Read( dataBuffer,
+                                  numOfBytes,
+                                  msTimeout,
+                                  timestamps ) ;
+}
+
+void
+SerialPort::EnableRxTimestamping( const bool enabled )
+{
+    mSerialPortImpl->EnableRxTimestamping( enabled ) ;
+    return ;
+}
+
+void
+SerialPort::StartCapture( const std::string& captureFilePath,
+                          const std::size_t  maxFileSize )
+{
+    mSerialPortImpl->StartCapture( captureFilePath,
+                                   maxFileSize ) ;
+    return ;
+}
+
+void
+SerialPort::StopCapture()
+{
+    mSerialPortImpl->StopCapture() ;
+    return ;
+}
+
+std::size_t
+SerialPort::ReadWithDeadline( unsigned char*     dataBuffer,
+                              const std::size_t  maxNumOfBytes,
+                              const unsigned int msTimeout )
+{
+    return mSerialPortImpl->ReadWithDeadline( dataBuffer,
+                                              maxNumOfBytes,
+                                              msTimeout ) ;
+}
+
+void
+SerialPort::ConfigureDelimiterFraming( const unsigned char delimiter )
+{
+    mSerialPortImpl->ConfigureDelimiterFraming( delimiter ) ;
+    return ;
+}
+
+void
+SerialPort::ConfigureFixedLengthFraming( const std::size_t frameLength )
+{
+    mSerialPortImpl->ConfigureFixedLengthFraming( frameLength ) ;
+    return ;
+}
+
+void
+SerialPort::ConfigureLengthPrefixFraming( const std::size_t prefixLength,
+                                          const bool        bigEndian )
+{
+    mSerialPortImpl->ConfigureLengthPrefixFraming( prefixLength,
+                                                   bigEndian ) ;
+    return ;
+}
+
+void
+SerialPort::DisableFraming()
+{
+    mSerialPortImpl->DisableFraming() ;
+    return ;
+}
+
+void
+SerialPort::ReadFrame( DataBuffer&        frameBuffer,
+                       const unsigned int msTimeout )
+{
+    mSerialPortImpl->ReadFrame( frameBuffer,
+                                msTimeout ) ;
+    return ;
+}
+
+unsigned char
+SerialPort::ReadByte( const unsigned int msTimeout )
+{
+    return mSerialPortImpl->ReadByte(msTimeout) ;
+}
+
+bool
+SerialPort::TryReadByte( unsigned char&     dataByte,
+                         const unsigned int msTimeout ) noexcept
+{
+    return mSerialPortImpl->TryReadByte( dataByte,
+                                         msTimeout ) ;
+}
+
+std::error_code
+SerialPort::TryRead( unsigned char*     dataBuffer,
+                     const unsigned int numOfBytes,
+                     const unsigned int msTimeout,
+                     std::size_t&       numOfBytesRead ) noexcept
+{
+    return mSerialPortImpl->TryRead( dataBuffer,
+                                     numOfBytes,
+                                     msTimeout,
+                                     numOfBytesRead ) ;
+}
+
+std::error_code
+SerialPort::TryWrite( const unsigned char* dataBuffer,
+                      const unsigned int   bufferSize ) noexcept
+{
+    return mSerialPortImpl->TryWrite( dataBuffer,
+                                      bufferSize ) ;
+}
+
+std::string
+SerialPort::ReadLine( const unsigned int msTimeout,
+                      const char         lineTerminator )
+{
+    return mSerialPortImpl->ReadLine( msTimeout,
+                                      lineTerminator ) ;
+}
+
+void
+SerialPort::ReadLine( std::string&       line,
+                      const unsigned int msTimeout,
+                      const char         lineTerminator )
+{
+    mSerialPortImpl->ReadLine( line,
+                               msTimeout,
+                               lineTerminator ) ;
+    return ;
+}
+
+void
+SerialPort::ReadLineIncremental( std::string&       line,
+                                 const unsigned int msTimeout,
+                                 const char         lineTerminator )
+{
+    mSerialPortImpl->ReadLineIncremental( line,
+                                          msTimeout,
+                                          lineTerminator ) ;
+    return ;
 }
 
 void
 SerialPort::Write(const DataBuffer& dataBuffer)
-    throw( NotOpen,
-           std::runtime_error )
 {
     mSerialPortImpl->Write( dataBuffer ) ;
     return ;
 }
 
 void
-SerialPort::Write(const std::string& dataString)
-    throw( NotOpen,
-           std::runtime_error )
+SerialPort::Write(std::string_view dataString)
 {
-    mSerialPortImpl->Write( reinterpret_cast<const unsigned char*>(dataString.c_str()),
+    mSerialPortImpl->Write( reinterpret_cast<const unsigned char*>(dataString.data()),
                             dataString.length() ) ;
     return ;
 }
 
+void
+SerialPort::Write( const unsigned char* dataBuffer,
+                   const unsigned int   bufferSize )
+{
+    mSerialPortImpl->Write( dataBuffer,
+                            bufferSize ) ;
+    return ;
+}
+
+void
+SerialPort::WriteGather( const GatherBuffer& gatherBuffer )
+{
+    mSerialPortImpl->WriteGather( gatherBuffer ) ;
+    return ;
+}
+
 void
 SerialPort::WriteByte( const unsigned char dataByte )
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
 {
     mSerialPortImpl->WriteByte( dataByte ) ;
     return ;
 }
 
+unsigned int
+SerialPort::WriteAsync( const unsigned char* dataBuffer,
+                        const unsigned int   bufferSize )
+{
+    return mSerialPortImpl->WriteAsync( dataBuffer,
+                                        bufferSize ) ;
+}
+
+unsigned int
+SerialPort::WriteAsync( const DataBuffer& dataBuffer )
+{
+    if ( 0 == dataBuffer.size() )
+    {
+        return 0 ;
+    }
+    return mSerialPortImpl->WriteAsync( &dataBuffer[0],
+                                        dataBuffer.size() ) ;
+}
+
+void
+SerialPort::ReadAsync( const std::size_t numOfBytes,
+                       ReadCallback      callback )
+{
+    mSerialPortImpl->ReadAsync( numOfBytes,
+                                std::move(callback) ) ;
+    return ;
+}
+
+unsigned int
+SerialPort::WriteAsync( const unsigned char* dataBuffer,
+                        const unsigned int   bufferSize,
+                        WriteCallback        callback )
+{
+    return mSerialPortImpl->WriteAsync( dataBuffer,
+                                        bufferSize,
+                                        std::move(callback) ) ;
+}
+
+std::size_t
+SerialPort::GetAsyncWriteQueueSize() const
+{
+    return mSerialPortImpl->GetAsyncWriteQueueSize() ;
+}
+
+void
+SerialPort::WaitForAsyncWrites( const unsigned int msTimeout )
+{
+    mSerialPortImpl->WaitForAsyncWrites( msTimeout ) ;
+    return ;
+}
+
+std::size_t
+SerialPort::GetOutputQueueByteCount() const
+{
+    return mSerialPortImpl->GetOutputQueueByteCount() ;
+}
+
+void
+SerialPort::DrainWriteBuffer( const unsigned int msTimeout )
+{
+    mSerialPortImpl->DrainWriteBuffer( msTimeout ) ;
+    return ;
+}
+
 /* ------------------------------------------------------------ */
 inline
 SerialPort::SerialPortImpl::SerialPortImpl( const std::string& serialPortName ) :
     mSerialPortName(serialPortName),
     mIsOpen(false),
     mFileDescriptor(-1),
+    mLatencyMode(SerialPort::LATENCY_MODE_DEFAULT),
+    mFramingMode(SerialPort::FRAMING_NONE),
+    mFrameDelimiter(0),
+    mFrameLength(0),
+    mFramePrefixLength(0),
+    mFramePrefixBigEndian(false),
     mOldPortSettings(),
-    mInputBuffer(),
-    mShadowInputBuffer(), 
-    mQueueMutex(),
-    mIsQueueDataAvailable(false)
+    mInputBuffer(RX_BUFFER_CAPACITY),
+    mDataAvailableSemaphore(),
+    mRxEventsPaused(false),
+    mOutputBuffer(TX_BUFFER_CAPACITY),
+    mTxDrainedSemaphore(),
+    mDataEventSemaphore(),
+    mRxChunkRing(0),
+    mRxChunkHead(0),
+    mRxChunkTail(0),
+    mRxTimestampsEnabled(false),
+    mCaptureEnabled(false),
+    mCaptureFileDescriptor(-1),
+    mCaptureMapping(0),
+    mCaptureMappingSize(0),
+    mCaptureHeader(0),
+    mCaptureData(0),
+    mCaptureMutex(),
+    mReaderThreadActive(false),
+    mReaderThread(),
+    mStatBytesReceived(0),
+    mStatBytesTransmitted(0),
+    mStatReadSyscalls(0),
+    mStatWriteSyscalls(0),
+    mStatReadTimeouts(0),
+    mStatWriteTimeouts(0),
+    mStatRxPauseEvents(0),
+    mStatRxHighWatermark(0),
+    mLatencyHistogramEnabled(false),
+    mTxEventsEnabled(false),
+    mEventMaskMutex(),
+    mPendingReads(),
+    mPendingWrites(),
+    mAsyncRequestMutex(),
+    mCompletionDeliveryMutex()
 {
-	//Initializing the mutex
-	if (pthread_mutex_init(&mQueueMutex, NULL) != 0)
+	//Initializing the semaphores used to signal data arrival and
+	//completion of asynchronous writes
+	if ((sem_init(&mDataAvailableSemaphore, 0, 0) != 0) ||
+	    (sem_init(&mTxDrainedSemaphore, 0, 0) != 0))
+    {
+		std::cerr << "SerialPort.cpp: Could not initialize semaphore!" << std::endl;
+	}
+	//Initializing the mutexes serializing event mask updates and
+	//asynchronous request bookkeeping
+	if ((pthread_mutex_init(&mEventMaskMutex, NULL) != 0) ||
+	    (pthread_mutex_init(&mAsyncRequestMutex, NULL) != 0) ||
+	    (pthread_mutex_init(&mCompletionDeliveryMutex, NULL) != 0) ||
+	    (pthread_mutex_init(&mCaptureMutex, NULL) != 0))
     {
 		std::cerr << "SerialPort.cpp: Could not initialize mutex!" << std::endl;
 	}
+	for (int i = 0; i < SerialPort::READ_LATENCY_NUM_BUCKETS; ++i)
+    {
+		mStatReadLatencyHistogram[i].store(0, std::memory_order_relaxed);
+	}
+	mReaderShutdownPipe[0] = -1;
+	mReaderShutdownPipe[1] = -1;
 }
 
 inline
@@ -619,14 +1371,14 @@ SerialPort::SerialPortImpl::~SerialPortImpl()
     {
         this->Close() ;
     }
+    this->StopCapture() ;
+    delete [] mRxChunkRing ;
     return ;
 }
 
 inline
 void
 SerialPort::SerialPortImpl::Open()
-    throw( SerialPort::OpenFailed,
-           SerialPort::AlreadyOpen )
 {
     /*
      * Throw an exception if the port is already open.
@@ -652,32 +1404,6 @@ SerialPort::SerialPortImpl::Open()
         throw SerialPort::OpenFailed( strerror(errno) )  ;
     }
 
-
-    PosixSignalDispatcher& signal_dispatcher = PosixSignalDispatcher::Instance() ;
-    signal_dispatcher.AttachHandler( SIGIO,
-                                     *this ) ;
-
-    /*
-     * Direct all SIGIO and SIGURG signals for the port to the current
-     * process.
-     */
-    if ( fcntl( mFileDescriptor,
-                F_SETOWN,
-                getpid() ) < 0 )
-    {
-        throw SerialPort::OpenFailed( strerror(errno) ) ;
-    }
-
-    /*
-     * Enable asynchronous I/O with the serial port.
-     */
-    if ( fcntl( mFileDescriptor,
-                F_SETFL,
-                FASYNC ) < 0 )
-    {
-        throw SerialPort::OpenFailed( strerror(errno) ) ;
-    }
-
     /*
      * Save the current settings of the serial port so they can be
      * restored when the serial port is closed.
@@ -734,8 +1460,33 @@ SerialPort::SerialPortImpl::Open()
      */
     mIsOpen = true ;
 
-    //Reset flag
-    mIsQueueDataAvailable = false;
+    //Discard any stale data and outstanding asynchronous requests
+    //from a previous session
+    mInputBuffer.Clear();
+    mOutputBuffer.Clear();
+    pthread_mutex_lock(&mAsyncRequestMutex);
+    mPendingReads.clear();
+    mPendingWrites.clear();
+    pthread_mutex_unlock(&mAsyncRequestMutex);
+    mRxEventsPaused = false;
+    mTxEventsEnabled = false;
+    mLatencyMode = SerialPort::LATENCY_MODE_DEFAULT;
+
+    /*
+     * Register the port with the event engine so that incoming data is
+     * drained into the input buffer as soon as it becomes available.
+     */
+    try
+    {
+        EpollEventEngine::Instance().AttachHandler( mFileDescriptor,
+                                                    *this ) ;
+    }
+    catch( const EpollEventEngine::CannotAttachHandler& attach_error )
+    {
+        close(mFileDescriptor) ;
+        mIsOpen = false ;
+        throw SerialPort::OpenFailed( attach_error.what() ) ;
+    }
 
     return ;
 }
@@ -743,7 +1494,6 @@ SerialPort::SerialPortImpl::Open()
 inline
 void
 SerialPort::SerialPortImpl::Close()
-    throw( SerialPort::NotOpen )
 {
     //
     // Throw an exception if the serial port is not open.
@@ -753,9 +1503,42 @@ SerialPort::SerialPortImpl::Close()
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    PosixSignalDispatcher& signal_dispatcher = PosixSignalDispatcher::Instance() ;
-    signal_dispatcher.DetachHandler( SIGIO,
-                                     *this ) ;
+    // Stop the dedicated reader thread, if one is running, before the
+    // file descriptor goes away. The self-pipe interrupts the
+    // thread's blocking poll().
+    //
+    if ( mReaderThreadActive )
+    {
+        mReaderThreadActive = false ;
+        const char shutdown_byte = 0 ;
+        ssize_t write_result = write( mReaderShutdownPipe[1],
+                                      &shutdown_byte,
+                                      1 ) ;
+        (void)write_result ;
+        pthread_join( mReaderThread,
+                      0 ) ;
+        close( mReaderShutdownPipe[0] ) ;
+        close( mReaderShutdownPipe[1] ) ;
+        mReaderShutdownPipe[0] = -1 ;
+        mReaderShutdownPipe[1] = -1 ;
+    }
+    //
+    // Stop delivery of read events for the port. Once DetachHandler()
+    // returns, no call to HandleReadEvent() is in progress and no
+    // further calls will be made, so the file descriptor can be safely
+    // closed.
+    //
+    try
+    {
+        EpollEventEngine::Instance().DetachHandler( mFileDescriptor ) ;
+    }
+    catch( const EpollEventEngine::CannotDetachHandler& )
+    {
+        //
+        // There is not much that can be done about a failed detach at
+        // this point; proceed with closing the port.
+        //
+    }
     //
     // Restore the old settings of the port.
     //
@@ -784,8 +1567,6 @@ SerialPort::SerialPortImpl::IsOpen() const
 inline
 bool
 SerialPort::SerialPortImpl::IsDataAvailable() const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
 {
     //
     // Make sure that the serial port is open.
@@ -795,106 +1576,194 @@ SerialPort::SerialPortImpl::IsDataAvailable() const
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Check if any data is available in the input buffer.
+    // Check if any data is available in the input buffer. The size of
+    // the ring buffer can be queried from any thread without locking.
+    //
+    return ( false == mInputBuffer.IsEmpty() ) ;
+}
+
+inline
+std::size_t
+SerialPort::SerialPortImpl::GetAvailableByteCount() const
+{
     //
-    //return ( mInputBuffer.size() > 0 ? true : false ) ;
-    //Here comes an (almost) thread safe alternative
-    return mIsQueueDataAvailable;
+    // Make sure that the serial port is open, like IsDataAvailable()
+    // and every other query method. Without this check, data left in
+    // the buffer after Close() would be reported as available.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    return mInputBuffer.GetSize() ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::SetBaudRate( const SerialPort::BaudRate baudRate )
-    throw( SerialPort::NotOpen,
-           SerialPort::UnsupportedBaudRate,
-           std::invalid_argument,
-           std::runtime_error )
+SerialPort::SerialPortImpl::SetDataEventSemaphore( sem_t* dataEventSemaphore )
+{
+    mDataEventSemaphore.store( dataEventSemaphore,
+                               std::memory_order_relaxed ) ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::EnableDedicatedReaderThread( const int cpuAffinity,
+                                                         const int realtimePriority )
 {
     //
-    // Throw an exception if the serial port is not open.
+    // Make sure that the serial port is open.
     //
     if ( ! this->IsOpen() )
     {
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Get the current settings of the serial port.
+    // Nothing to do if the reader thread is already running.
     //
-    termios port_settings ;
-    if ( tcgetattr( mFileDescriptor,
-                    &port_settings ) < 0 )
+    if ( mReaderThreadActive )
+    {
+        return ;
+    }
+    if ( pipe( mReaderShutdownPipe ) < 0 )
     {
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
-    // Set the baud rate for both input and output.
+    // Stop read-event delivery from the event engine; from here on
+    // the reader thread is the sole producer of the input buffer.
+    // Write events stay with the engine so asynchronous writes keep
+    // working.
     //
-    if ( ( cfsetispeed( &port_settings,
-                        baudRate ) < 0 ) ||
-         ( cfsetospeed( &port_settings,
-                        baudRate ) < 0 ) )
+    mReaderThreadActive = true ;
+    this->UpdateHandlerEvents() ;
+    //
+    // Changing the event mask does not interrupt a dispatch already
+    // running on the event loop; wait for it so the reader thread is
+    // the only producer of the input buffer from its first iteration.
+    //
+    EpollEventEngine::Instance().SynchronizeWithDispatch() ;
+    if ( pthread_create( &mReaderThread,
+                         0,
+                         ReaderThreadFunc,
+                         this ) != 0 )
     {
-        //
-        // If any of the settings fail, we abandon this method.
-        //
-        throw SerialPort::UnsupportedBaudRate( ERR_MSG_UNSUPPORTED_BAUD ) ;
+        const int thread_errno = errno ;
+        mReaderThreadActive = false ;
+        this->UpdateHandlerEvents() ;
+        close( mReaderShutdownPipe[0] ) ;
+        close( mReaderShutdownPipe[1] ) ;
+        mReaderShutdownPipe[0] = -1 ;
+        mReaderShutdownPipe[1] = -1 ;
+        throw std::runtime_error( strerror(thread_errno) ) ;
     }
     //
-    // Set the new attributes of the serial port.
+    // Apply the optional core pinning and realtime priority on a
+    // best-effort basis; both typically need elevated privileges.
     //
-    if ( tcsetattr( mFileDescriptor,
-                    TCSANOW,
-                    &port_settings ) < 0 )
+    if ( cpuAffinity >= 0 )
     {
-        throw SerialPort::UnsupportedBaudRate( strerror(errno) ) ;
+        cpu_set_t cpu_set ;
+        CPU_ZERO( &cpu_set ) ;
+        CPU_SET( cpuAffinity, &cpu_set ) ;
+        pthread_setaffinity_np( mReaderThread,
+                                sizeof(cpu_set),
+                                &cpu_set ) ;
+    }
+    if ( realtimePriority > 0 )
+    {
+        struct sched_param scheduling_parameters ;
+        scheduling_parameters.sched_priority = realtimePriority ;
+        pthread_setschedparam( mReaderThread,
+                               SCHED_FIFO,
+                               &scheduling_parameters ) ;
     }
     return ;
 }
 
-inline
-SerialPort::BaudRate
-SerialPort::SerialPortImpl::GetBaudRate() const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+void*
+SerialPort::SerialPortImpl::ReaderThreadFunc( void* serialPortImpl )
 {
-    //
-    // Make sure that the serial port is open.
-    //
-    if ( ! this->IsOpen() )
-    {
-        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
-    }
-    //
-    // Read the current serial port settings.
-    //
-    termios port_settings ;
-    if ( tcgetattr( mFileDescriptor,
-                    &port_settings ) < 0 )
+    SerialPortImpl* port_impl = static_cast<SerialPortImpl*>(serialPortImpl) ;
+    while( port_impl->mReaderThreadActive )
     {
-        throw std::runtime_error( strerror(errno) ) ;
+        //
+        // If the input buffer is full, back off briefly until the
+        // consumer has made space; polling the descriptor would
+        // return immediately without any way to store the data.
+        //
+        if ( port_impl->mRxEventsPaused )
+        {
+            usleep(1000) ;
+            continue ;
+        }
+        struct pollfd poll_info[2] ;
+        poll_info[0].fd      = port_impl->mFileDescriptor ;
+        poll_info[0].events  = POLLIN ;
+        poll_info[0].revents = 0 ;
+        poll_info[1].fd      = port_impl->mReaderShutdownPipe[0] ;
+        poll_info[1].events  = POLLIN ;
+        poll_info[1].revents = 0 ;
+        const int poll_result = poll( poll_info,
+                                      2,
+                                      -1 ) ;
+        if ( poll_result < 0 )
+        {
+            if ( EINTR == errno )
+            {
+                continue ;
+            }
+            break ;
+        }
+        if ( poll_info[1].revents & POLLIN )
+        {
+            //
+            // The port is being closed.
+            //
+            break ;
+        }
+        if ( poll_info[0].revents & ( POLLIN | POLLERR | POLLHUP ) )
+        {
+            //
+            // Drain the port with the same bulk path the event engine
+            // uses; this thread is the sole producer of the input
+            // buffer while the mode is active.
+            //
+            port_impl->HandleReadEvent() ;
+            if ( poll_info[0].revents & ( POLLERR | POLLHUP ) )
+            {
+                //
+                // The descriptor cannot produce more data; wait for
+                // shutdown so the loop does not spin on the error.
+                //
+                unsigned char shutdown_byte = 0 ;
+                ssize_t read_result = read( port_impl->mReaderShutdownPipe[0],
+                                            &shutdown_byte,
+                                            1 ) ;
+                (void)read_result ;
+                break ;
+            }
+        }
     }
-    //
-    // Obtain the input baud rate from the current settings.
-    //
-    return SerialPort::BaudRate(cfgetispeed( &port_settings )) ;
+    return 0 ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::SetCharSize( const SerialPort::CharacterSize charSize )
-    throw( SerialPort::NotOpen,
-           std::invalid_argument,
-           std::runtime_error )
+SerialPort::SerialPortImpl::ApplySettings( const SerialPort::Settings& settings )
 {
     //
-    // Make sure that the serial port is open.
+    // Throw an exception if the serial port is not open.
     //
     if ( ! this->IsOpen() )
     {
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Get the current settings of the serial port.
+    // Get the current settings of the serial port once; all fields
+    // are composed into this structure and written back with a single
+    // tcsetattr() call.
     //
     termios port_settings ;
     if ( tcgetattr( mFileDescriptor,
@@ -903,65 +1772,97 @@ SerialPort::SerialPortImpl::SetCharSize( const SerialPort::CharacterSize charSiz
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
+    // Set the baud rate for both input and output.
+    //
+    if ( ( cfsetispeed( &port_settings,
+                        settings.baudRate ) < 0 ) ||
+         ( cfsetospeed( &port_settings,
+                        settings.baudRate ) < 0 ) )
+    {
+        throw SerialPort::UnsupportedBaudRate( ERR_MSG_UNSUPPORTED_BAUD ) ;
+    }
+    //
     // Set the character size.
     //
     port_settings.c_cflag &= ~CSIZE ;
-    port_settings.c_cflag |= charSize ;
+    port_settings.c_cflag |= settings.charSize ;
     //
-    // Apply the modified settings.
+    // Set the parity type.
     //
-    if ( tcsetattr( mFileDescriptor,
-                    TCSANOW,
-                    &port_settings ) < 0 )
+    switch( settings.parityType )
     {
-        throw std::invalid_argument( strerror(errno) ) ;
-    }
-    return ;
-}
-
-inline
-SerialPort::CharacterSize
-SerialPort::SerialPortImpl::GetCharSize() const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
-{
+    case SerialPort::PARITY_EVEN:
+        port_settings.c_cflag |= PARENB ;
+        port_settings.c_cflag &= ~PARODD ;
+        port_settings.c_iflag |= INPCK ;
+        break ;
+    case SerialPort::PARITY_ODD:
+        port_settings.c_cflag |= ( PARENB | PARODD ) ;
+        port_settings.c_iflag |= INPCK ;
+        break ;
+    case SerialPort::PARITY_NONE:
+        port_settings.c_cflag &= ~(PARENB) ;
+        port_settings.c_iflag |= IGNPAR ;
+        break ;
+    default:
+        throw std::invalid_argument( ERR_MSG_INVALID_PARITY ) ;
+        break ;
+    }
     //
-    // Make sure that the serial port is open.
+    // Set the number of stop bits.
     //
-    if ( ! this->IsOpen() )
+    switch( settings.stopBits )
     {
-        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    case SerialPort::STOP_BITS_1:
+        port_settings.c_cflag &= ~(CSTOPB) ;
+        break ;
+    case SerialPort::STOP_BITS_2:
+        port_settings.c_cflag |= CSTOPB ;
+        break ;
+    default:
+        throw std::invalid_argument( ERR_MSG_INVALID_STOP_BITS ) ;
+        break ;
     }
     //
-    // Get the current port settings.
+    // Set the flow control.
     //
-    termios port_settings ;
-    if ( tcgetattr( mFileDescriptor,
-                    &port_settings ) < 0 )
+    switch( settings.flowControl )
     {
-        throw std::runtime_error( strerror(errno) ) ;
+    case SerialPort::FLOW_CONTROL_HARD:
+        port_settings.c_cflag |= CRTSCTS ;
+        break ;
+    case SerialPort::FLOW_CONTROL_NONE:
+        port_settings.c_cflag &= ~(CRTSCTS) ;
+        break ;
+    default:
+        throw std::invalid_argument( ERR_MSG_INVALID_FLOW_CONTROL ) ;
+        break ;
     }
     //
-    // Read the character size from the setttings.
+    // Write the composed settings to the port with a single call.
     //
-    return SerialPort::CharacterSize( port_settings.c_cflag & CSIZE ) ;
+    if ( tcsetattr( mFileDescriptor,
+                    TCSANOW,
+                    &port_settings ) < 0 )
+    {
+        throw std::invalid_argument( strerror(errno) ) ;
+    }
+    return ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::SetFlowControl( const SerialPort::FlowControl   flowControl )
-    throw( SerialPort::NotOpen,
-           std::invalid_argument )
+SerialPort::SerialPortImpl::SetBaudRate( const SerialPort::BaudRate baudRate )
 {
     //
-    // Make sure that the serial port is open.
+    // Throw an exception if the serial port is not open.
     //
     if ( ! this->IsOpen() )
     {
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Get the current port settings.
+    // Get the current settings of the serial port.
     //
     termios port_settings ;
     if ( tcgetattr( mFileDescriptor,
@@ -970,36 +1871,33 @@ SerialPort::SerialPortImpl::SetFlowControl( const SerialPort::FlowControl   flow
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
-    // Set the flow control.
+    // Set the baud rate for both input and output.
     //
-    switch( flowControl )
+    if ( ( cfsetispeed( &port_settings,
+                        baudRate ) < 0 ) ||
+         ( cfsetospeed( &port_settings,
+                        baudRate ) < 0 ) )
     {
-    case SerialPort::FLOW_CONTROL_HARD:
-        port_settings.c_cflag |= CRTSCTS ;
-        break ;
-    case SerialPort::FLOW_CONTROL_NONE:
-        port_settings.c_cflag &= ~(CRTSCTS) ;
-        break ;
-    default:
-        throw std::invalid_argument( ERR_MSG_INVALID_FLOW_CONTROL ) ;
-        break ;
+        //
+        // If any of the settings fail, we abandon this method.
+        //
+        throw SerialPort::UnsupportedBaudRate( ERR_MSG_UNSUPPORTED_BAUD ) ;
     }
     //
-    // Apply the modified settings.
+    // Set the new attributes of the serial port.
     //
     if ( tcsetattr( mFileDescriptor,
                     TCSANOW,
                     &port_settings ) < 0 )
     {
-        throw std::invalid_argument( strerror(errno) ) ;
+        throw SerialPort::UnsupportedBaudRate( strerror(errno) ) ;
     }
     return ;
 }
 
 inline
-SerialPort::FlowControl
-SerialPort::SerialPortImpl::GetFlowControl() const
-    throw( SerialPort::NotOpen )
+SerialPort::BaudRate
+SerialPort::SerialPortImpl::GetBaudRate() const
 {
     //
     // Make sure that the serial port is open.
@@ -1009,7 +1907,7 @@ SerialPort::SerialPortImpl::GetFlowControl() const
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Get the current port settings.
+    // Read the current serial port settings.
     //
     termios port_settings ;
     if ( tcgetattr( mFileDescriptor,
@@ -1018,22 +1916,90 @@ SerialPort::SerialPortImpl::GetFlowControl() const
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
-    // If CRTSCTS is set then we are using hardware flow
-    // control. Otherwise, we are not using any flow control.
+    // Obtain the input baud rate from the current settings.
     //
-    if ( port_settings.c_cflag & CRTSCTS )
+    return SerialPort::BaudRate(cfgetispeed( &port_settings )) ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::SetCustomBaudRate( const unsigned int baudRate )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
     {
-        return SerialPort::FLOW_CONTROL_HARD ;
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
-    return SerialPort::FLOW_CONTROL_NONE ;
+    if ( 0 == baudRate )
+    {
+        throw std::invalid_argument( ERR_MSG_UNSUPPORTED_BAUD ) ;
+    }
+#ifdef __linux__
+    //
+    // Get the current termios2 settings of the serial port.
+    //
+    struct termios2 port_settings ;
+    if ( ioctl( mFileDescriptor,
+                TCGETS2,
+                &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    //
+    // Select the BOTHER flag so that the baud rate is taken from the
+    // c_ispeed/c_ospeed fields instead of the closed Bxxx table, and
+    // set the requested rate for both directions.
+    //
+    port_settings.c_cflag &= ~static_cast<tcflag_t>(CBAUD) ;
+    port_settings.c_cflag |= BOTHER ;
+    port_settings.c_ispeed = baudRate ;
+    port_settings.c_ospeed = baudRate ;
+    //
+    // Apply the modified settings. The driver may reject rates its
+    // hardware cannot generate.
+    //
+    if ( ioctl( mFileDescriptor,
+                TCSETS2,
+                &port_settings ) < 0 )
+    {
+        throw SerialPort::UnsupportedBaudRate( strerror(errno) ) ;
+    }
+    return ;
+#else
+    throw SerialPort::UnsupportedBaudRate( ERR_MSG_UNSUPPORTED_BAUD ) ;
+#endif
+}
+
+inline
+unsigned int
+SerialPort::SerialPortImpl::GetCustomBaudRate() const
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+#ifdef __linux__
+    struct termios2 port_settings ;
+    if ( ioctl( mFileDescriptor,
+                TCGETS2,
+                &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    return port_settings.c_ospeed ;
+#else
+    throw std::runtime_error( ERR_MSG_UNKNOWN_BAUD ) ;
+#endif
 }
 
 inline
 void
-SerialPort::SerialPortImpl::SetParity( const SerialPort::Parity parityType )
-    throw( SerialPort::NotOpen,
-           std::invalid_argument,
-           std::runtime_error )
+SerialPort::SerialPortImpl::SetCharSize( const SerialPort::CharacterSize charSize )
 {
     //
     // Make sure that the serial port is open.
@@ -1043,7 +2009,7 @@ SerialPort::SerialPortImpl::SetParity( const SerialPort::Parity parityType )
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Get the current port settings.
+    // Get the current settings of the serial port.
     //
     termios port_settings ;
     if ( tcgetattr( mFileDescriptor,
@@ -1052,29 +2018,12 @@ SerialPort::SerialPortImpl::SetParity( const SerialPort::Parity parityType )
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
-    // Set the parity type depending on the specified parameter.
+    // Set the character size.
     //
-    switch( parityType )
-    {
-    case SerialPort::PARITY_EVEN:
-        port_settings.c_cflag |= PARENB ;
-        port_settings.c_cflag &= ~PARODD ;
-        port_settings.c_iflag |= INPCK ;
-        break ;
-    case SerialPort::PARITY_ODD:
-        port_settings.c_cflag |= ( PARENB | PARODD ) ;
-        port_settings.c_iflag |= INPCK ;
-        break ;
-    case SerialPort::PARITY_NONE:
-        port_settings.c_cflag &= ~(PARENB) ;
-        port_settings.c_iflag |= IGNPAR ;
-        break ;
-    default:
-        throw std::invalid_argument( ERR_MSG_INVALID_PARITY ) ;
-        break ;
-    }
+    port_settings.c_cflag &= ~CSIZE ;
+    port_settings.c_cflag |= charSize ;
     //
-    // Apply the modified port settings.
+    // Apply the modified settings.
     //
     if ( tcsetattr( mFileDescriptor,
                     TCSANOW,
@@ -1086,9 +2035,8 @@ SerialPort::SerialPortImpl::SetParity( const SerialPort::Parity parityType )
 }
 
 inline
-SerialPort::Parity
-SerialPort::SerialPortImpl::GetParity() const
-    throw(SerialPort::NotOpen)
+SerialPort::CharacterSize
+SerialPort::SerialPortImpl::GetCharSize() const
 {
     //
     // Make sure that the serial port is open.
@@ -1107,33 +2055,14 @@ SerialPort::SerialPortImpl::GetParity() const
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
-    // Get the parity type from the current settings.
-    //
-    if ( port_settings.c_cflag & PARENB )
-    {
-        //
-        // Parity is enabled. Lets check if it is odd or even.
-        //
-        if ( port_settings.c_cflag & PARODD )
-        {
-            return SerialPort::PARITY_ODD ;
-        }
-        else
-        {
-            return SerialPort::PARITY_EVEN ;
-        }
-    }
-    //
-    // Parity is disabled.
+    // Read the character size from the setttings.
     //
-    return SerialPort::PARITY_NONE ;
+    return SerialPort::CharacterSize( port_settings.c_cflag & CSIZE ) ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::SetNumOfStopBits( const SerialPort::StopBits numOfStopBits )
-    throw( SerialPort::NotOpen,
-           std::invalid_argument )
+SerialPort::SerialPortImpl::SetFlowControl( const SerialPort::FlowControl   flowControl )
 {
     //
     // Make sure that the serial port is open.
@@ -1152,18 +2081,18 @@ SerialPort::SerialPortImpl::SetNumOfStopBits( const SerialPort::StopBits numOfSt
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
-    // Set the number of stop bits.
+    // Set the flow control.
     //
-    switch( numOfStopBits )
+    switch( flowControl )
     {
-    case SerialPort::STOP_BITS_1:
-        port_settings.c_cflag &= ~(CSTOPB) ;
+    case SerialPort::FLOW_CONTROL_HARD:
+        port_settings.c_cflag |= CRTSCTS ;
         break ;
-    case SerialPort::STOP_BITS_2:
-        port_settings.c_cflag |= CSTOPB ;
+    case SerialPort::FLOW_CONTROL_NONE:
+        port_settings.c_cflag &= ~(CRTSCTS) ;
         break ;
     default:
-        throw std::invalid_argument( ERR_MSG_INVALID_STOP_BITS ) ;
+        throw std::invalid_argument( ERR_MSG_INVALID_FLOW_CONTROL ) ;
         break ;
     }
     //
@@ -1179,9 +2108,8 @@ SerialPort::SerialPortImpl::SetNumOfStopBits( const SerialPort::StopBits numOfSt
 }
 
 inline
-SerialPort::StopBits
-SerialPort::SerialPortImpl::GetNumOfStopBits() const
-    throw(SerialPort::NotOpen)
+SerialPort::FlowControl
+SerialPort::SerialPortImpl::GetFlowControl() const
 {
     //
     // Make sure that the serial port is open.
@@ -1200,82 +2128,1514 @@ SerialPort::SerialPortImpl::GetNumOfStopBits() const
         throw std::runtime_error( strerror(errno) ) ;
     }
     //
-    // If CSTOPB is set then we are using two stop bits, otherwise we
-    // are using 1 stop bit.
+    // If CRTSCTS is set then we are using hardware flow
+    // control. Otherwise, we are not using any flow control.
     //
-    if ( port_settings.c_cflag & CSTOPB )
+    if ( port_settings.c_cflag & CRTSCTS )
     {
-        return SerialPort::STOP_BITS_2 ;
+        return SerialPort::FLOW_CONTROL_HARD ;
     }
-    return SerialPort::STOP_BITS_1 ;
-}
-
-inline
-void
-SerialPort::SerialPortImpl::SetDtr( const bool dtrState )
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
-{
-    this->SetModemControlLine( TIOCM_DTR, 
-                               dtrState ) ;
-    return ;
+    return SerialPort::FLOW_CONTROL_NONE ;
 }
 
-inline
-bool
-SerialPort::SerialPortImpl::GetDtr() const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
-{
-    return this->GetModemControlLine( TIOCM_DTR ) ;
-}    
-
 inline
 void
-SerialPort::SerialPortImpl::SetRts( const bool rtsState )
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
-{
-    this->SetModemControlLine( TIOCM_RTS, 
-                               rtsState ) ;
-    return ;
-}
-
-inline
-bool
-SerialPort::SerialPortImpl::GetRts() const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+SerialPort::SerialPortImpl::SetLatencyMode( const SerialPort::LatencyMode latencyMode )
 {
-    return this->GetModemControlLine( TIOCM_RTS ) ;
-}    
-
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Get the current settings of the serial port.
+    //
+    termios port_settings ;
+    if ( tcgetattr( mFileDescriptor,
+                    &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    //
+    // Select the read-coalescing policy. VMIN/VTIME only take effect
+    // when the port is read in blocking mode, but they are configured
+    // here so the chosen policy applies however the descriptor is
+    // used.
+    //
+    switch( latencyMode )
+    {
+    case SerialPort::LATENCY_MODE_LOW:
+        //
+        // Deliver every byte as soon as it arrives.
+        //
+        port_settings.c_cc[ VMIN  ] = 0 ;
+        port_settings.c_cc[ VTIME ] = 0 ;
+        break ;
+    case SerialPort::LATENCY_MODE_THROUGHPUT:
+        //
+        // Let reads coalesce up to 255 bytes or until the line has
+        // been idle for 100 ms, reducing the number of wakeups during
+        // bulk transfers.
+        //
+        port_settings.c_cc[ VMIN  ] = 255 ;
+        port_settings.c_cc[ VTIME ] = 1 ;
+        break ;
+    default:
+        throw std::invalid_argument( ERR_MSG_INVALID_LATENCY_MODE ) ;
+        break ;
+    }
+    //
+    // Apply the modified settings.
+    //
+    if ( tcsetattr( mFileDescriptor,
+                    TCSANOW,
+                    &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+#ifdef __linux__
+    //
+    // Set or clear the driver's low-latency flag. On USB-serial
+    // adapters such as FTDI devices this reduces the latency timer
+    // from its 16 ms default to 1 ms. This is done on a best-effort
+    // basis: devices whose drivers do not implement TIOCGSERIAL (for
+    // example pseudo-terminals) keep their driver defaults.
+    //
+    struct serial_struct serial_info ;
+    if ( ioctl( mFileDescriptor,
+                TIOCGSERIAL,
+                &serial_info ) >= 0 )
+    {
+        if ( SerialPort::LATENCY_MODE_LOW == latencyMode )
+        {
+            serial_info.flags |= ASYNC_LOW_LATENCY ;
+        }
+        else
+        {
+            serial_info.flags &= ~ASYNC_LOW_LATENCY ;
+        }
+        ioctl( mFileDescriptor,
+               TIOCSSERIAL,
+               &serial_info ) ;
+    }
+#endif
+    mLatencyMode = latencyMode ;
+    return ;
+}
+
+inline
+SerialPort::LatencyMode
+SerialPort::SerialPortImpl::GetLatencyMode() const
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    return mLatencyMode ;
+}
+
+inline
+SerialPort::Statistics
+SerialPort::SerialPortImpl::GetStatistics() const
+{
+    SerialPort::Statistics statistics ;
+    statistics.bytesReceived =
+        mStatBytesReceived.load(std::memory_order_relaxed) ;
+    statistics.bytesTransmitted =
+        mStatBytesTransmitted.load(std::memory_order_relaxed) ;
+    statistics.readSyscalls =
+        mStatReadSyscalls.load(std::memory_order_relaxed) ;
+    statistics.writeSyscalls =
+        mStatWriteSyscalls.load(std::memory_order_relaxed) ;
+    statistics.readTimeouts =
+        mStatReadTimeouts.load(std::memory_order_relaxed) ;
+    statistics.writeTimeouts =
+        mStatWriteTimeouts.load(std::memory_order_relaxed) ;
+    statistics.rxPauseEvents =
+        mStatRxPauseEvents.load(std::memory_order_relaxed) ;
+    statistics.rxBufferHighWatermark =
+        mStatRxHighWatermark.load(std::memory_order_relaxed) ;
+    for( int i = 0 ; i < SerialPort::READ_LATENCY_NUM_BUCKETS ; ++i )
+    {
+        statistics.readLatencyHistogram[i] =
+            mStatReadLatencyHistogram[i].load(std::memory_order_relaxed) ;
+    }
+    return statistics ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::ResetStatistics()
+{
+    mStatBytesReceived.store(0, std::memory_order_relaxed) ;
+    mStatBytesTransmitted.store(0, std::memory_order_relaxed) ;
+    mStatReadSyscalls.store(0, std::memory_order_relaxed) ;
+    mStatWriteSyscalls.store(0, std::memory_order_relaxed) ;
+    mStatReadTimeouts.store(0, std::memory_order_relaxed) ;
+    mStatWriteTimeouts.store(0, std::memory_order_relaxed) ;
+    mStatRxPauseEvents.store(0, std::memory_order_relaxed) ;
+    mStatRxHighWatermark.store(0, std::memory_order_relaxed) ;
+    for( int i = 0 ; i < SerialPort::READ_LATENCY_NUM_BUCKETS ; ++i )
+    {
+        mStatReadLatencyHistogram[i].store(0, std::memory_order_relaxed) ;
+    }
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::EnableReadLatencyHistogram( const bool enabled )
+{
+    mLatencyHistogramEnabled.store( enabled,
+                                    std::memory_order_relaxed ) ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::SetParity( const SerialPort::Parity parityType )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Get the current port settings.
+    //
+    termios port_settings ;
+    if ( tcgetattr( mFileDescriptor,
+                    &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    //
+    // Set the parity type depending on the specified parameter.
+    //
+    switch( parityType )
+    {
+    case SerialPort::PARITY_EVEN:
+        port_settings.c_cflag |= PARENB ;
+        port_settings.c_cflag &= ~PARODD ;
+        port_settings.c_iflag |= INPCK ;
+        break ;
+    case SerialPort::PARITY_ODD:
+        port_settings.c_cflag |= ( PARENB | PARODD ) ;
+        port_settings.c_iflag |= INPCK ;
+        break ;
+    case SerialPort::PARITY_NONE:
+        port_settings.c_cflag &= ~(PARENB) ;
+        port_settings.c_iflag |= IGNPAR ;
+        break ;
+    default:
+        throw std::invalid_argument( ERR_MSG_INVALID_PARITY ) ;
+        break ;
+    }
+    //
+    // Apply the modified port settings.
+    //
+    if ( tcsetattr( mFileDescriptor,
+                    TCSANOW,
+                    &port_settings ) < 0 )
+    {
+        throw std::invalid_argument( strerror(errno) ) ;
+    }
+    return ;
+}
+
+inline
+SerialPort::Parity
+SerialPort::SerialPortImpl::GetParity() const
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Get the current port settings.
+    //
+    termios port_settings ;
+    if ( tcgetattr( mFileDescriptor,
+                    &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    //
+    // Get the parity type from the current settings.
+    //
+    if ( port_settings.c_cflag & PARENB )
+    {
+        //
+        // Parity is enabled. Lets check if it is odd or even.
+        //
+        if ( port_settings.c_cflag & PARODD )
+        {
+            return SerialPort::PARITY_ODD ;
+        }
+        else
+        {
+            return SerialPort::PARITY_EVEN ;
+        }
+    }
+    //
+    // Parity is disabled.
+    //
+    return SerialPort::PARITY_NONE ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::SetNumOfStopBits( const SerialPort::StopBits numOfStopBits )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Get the current port settings.
+    //
+    termios port_settings ;
+    if ( tcgetattr( mFileDescriptor,
+                    &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    //
+    // Set the number of stop bits.
+    //
+    switch( numOfStopBits )
+    {
+    case SerialPort::STOP_BITS_1:
+        port_settings.c_cflag &= ~(CSTOPB) ;
+        break ;
+    case SerialPort::STOP_BITS_2:
+        port_settings.c_cflag |= CSTOPB ;
+        break ;
+    default:
+        throw std::invalid_argument( ERR_MSG_INVALID_STOP_BITS ) ;
+        break ;
+    }
+    //
+    // Apply the modified settings.
+    //
+    if ( tcsetattr( mFileDescriptor,
+                    TCSANOW,
+                    &port_settings ) < 0 )
+    {
+        throw std::invalid_argument( strerror(errno) ) ;
+    }
+    return ;
+}
+
+inline
+SerialPort::StopBits
+SerialPort::SerialPortImpl::GetNumOfStopBits() const
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Get the current port settings.
+    //
+    termios port_settings ;
+    if ( tcgetattr( mFileDescriptor,
+                    &port_settings ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    //
+    // If CSTOPB is set then we are using two stop bits, otherwise we
+    // are using 1 stop bit.
+    //
+    if ( port_settings.c_cflag & CSTOPB )
+    {
+        return SerialPort::STOP_BITS_2 ;
+    }
+    return SerialPort::STOP_BITS_1 ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::SetDtr( const bool dtrState )
+{
+    this->SetModemControlLine( TIOCM_DTR, 
+                               dtrState ) ;
+    return ;
+}
+
+inline
+bool
+SerialPort::SerialPortImpl::GetDtr() const
+{
+    return this->GetModemControlLine( TIOCM_DTR ) ;
+}    
+
+inline
+void
+SerialPort::SerialPortImpl::SetRts( const bool rtsState )
+{
+    this->SetModemControlLine( TIOCM_RTS, 
+                               rtsState ) ;
+    return ;
+}
+
+inline
+bool
+SerialPort::SerialPortImpl::GetRts() const
+{
+    return this->GetModemControlLine( TIOCM_RTS ) ;
+}    
+
+
+inline
+bool
+SerialPort::SerialPortImpl::GetCts() const
+{
+    return this->GetModemControlLine( TIOCM_CTS ) ;
+}    
+
+
+inline
+bool
+SerialPort::SerialPortImpl::GetDsr() const
+{
+    return this->GetModemControlLine( TIOCM_DSR ) ;
+}    
+
+inline
+void
+SerialPort::SerialPortImpl::SetModemControlLine( const int  modemLine,
+                                                 const bool lineState )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // :TODO: Check to make sure that modemLine is a valid value.
+    // 
+    // Set or unset the specified bit according to the value of
+    // lineState.
+    //
+    int ioctl_result = -1 ;
+    if ( true == lineState )
+    {
+        int set_line_mask = modemLine ;
+        ioctl_result = ioctl( mFileDescriptor, 
+                              TIOCMBIS,
+                              &set_line_mask ) ;
+    }
+    else
+    {
+        int reset_line_mask = modemLine ;
+        ioctl_result = ioctl( mFileDescriptor, 
+                              TIOCMBIC,
+                              &reset_line_mask ) ;
+    }
+    //
+    // Check for errors. 
+    //
+    if ( -1 == ioctl_result )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    return ;
+}
+
+inline
+bool
+SerialPort::SerialPortImpl::GetModemControlLine( const int modemLine ) const
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Use an ioctl() call to get the state of the line.
+    //
+    int serial_port_state = 0 ;
+    if ( -1 == ioctl( mFileDescriptor,
+                      TIOCMGET,
+                      &serial_port_state ) )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    //
+    // :TODO: Verify that modemLine is a valid value.
+    //
+    return ( serial_port_state & modemLine ) ;
+}
+
+inline
+int
+SerialPort::SerialPortImpl::WaitForDataTimed( const unsigned int msTimeout ) noexcept
+{
+    return this->WaitForMoreDataTimed( 0,
+                                       msTimeout ) ;
+}
+
+inline
+int
+SerialPort::SerialPortImpl::WaitForMoreDataTimed( const std::size_t  previousSize,
+                                                  const unsigned int msTimeout ) noexcept
+{
+    //
+    // Compute the absolute deadline at which the wait must give up.
+    //
+    struct timespec deadline = { 0, 0 } ;
+    if ( msTimeout > 0 )
+    {
+        try
+        {
+            deadline = ComputeDeadline( msTimeout ) ;
+        }
+        catch( const std::runtime_error& )
+        {
+            return EINVAL ;
+        }
+    }
+    //
+    // Note the entry time if the read-latency histogram is being
+    // populated.
+    //
+    const bool record_latency =
+        mLatencyHistogramEnabled.load(std::memory_order_relaxed) &&
+        ( mInputBuffer.GetSize() <= previousSize ) ;
+    struct timespec wait_start = { 0, 0 } ;
+    if ( record_latency )
+    {
+        clock_gettime( CLOCK_MONOTONIC, &wait_start ) ;
+    }
+    //
+    // Wait for data to be available. The semaphore is posted from
+    // HandleReadEvent() whenever new data is added to the input
+    // buffer so this thread wakes up as soon as data arrives instead
+    // of polling the buffer once every millisecond. The semaphore may
+    // carry posts for data that has already been consumed, so the
+    // buffer state is re-checked after every wakeup.
+    //
+    while( mInputBuffer.GetSize() <= previousSize )
+    {
+        int wait_result = 0 ;
+        if ( 0 == msTimeout )
+        {
+            //
+            // No timeout was specified so wait indefinitely for data
+            // to arrive.
+            //
+            wait_result = sem_wait( &mDataAvailableSemaphore ) ;
+        }
+        else
+        {
+            //
+            // Wait until either data arrives or the deadline passes.
+            //
+            wait_result = sem_timedwait( &mDataAvailableSemaphore,
+                                         &deadline ) ;
+        }
+        if ( ( wait_result < 0 ) &&
+             ( EINTR != errno ) )
+        {
+            if ( ETIMEDOUT == errno )
+            {
+                mStatReadTimeouts.fetch_add(1, std::memory_order_relaxed) ;
+            }
+            if ( record_latency )
+            {
+                this->RecordWaitLatency( wait_start ) ;
+            }
+            return errno ;
+        }
+    }
+    if ( record_latency )
+    {
+        this->RecordWaitLatency( wait_start ) ;
+    }
+    return 0 ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::RecordWaitLatency( const struct timespec& waitStart ) noexcept
+{
+    struct timespec wait_end ;
+    clock_gettime( CLOCK_MONOTONIC, &wait_end ) ;
+    unsigned long long elapsed_us =
+        ( wait_end.tv_sec - waitStart.tv_sec ) * 1000000ull +
+        ( wait_end.tv_nsec - waitStart.tv_nsec ) / 1000 ;
+    //
+    // Bucket b counts waits of [2^b, 2^(b+1)) microseconds; the last
+    // bucket absorbs anything longer.
+    //
+    int bucket = 0 ;
+    while( ( elapsed_us > 1 ) &&
+           ( bucket < ( SerialPort::READ_LATENCY_NUM_BUCKETS - 1 ) ) )
+    {
+        elapsed_us >>= 1 ;
+        ++bucket ;
+    }
+    mStatReadLatencyHistogram[bucket].fetch_add(1, std::memory_order_relaxed) ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::WaitForData( const unsigned int msTimeout )
+{
+    const int wait_error = this->WaitForDataTimed( msTimeout ) ;
+    if ( ETIMEDOUT == wait_error )
+    {
+        throw SerialPort::ReadTimeout() ;
+    }
+    if ( 0 != wait_error )
+    {
+        throw std::runtime_error( strerror(wait_error) ) ;
+    }
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::UpdateHandlerEvents()
+{
+    //
+    // The mask is composed from the current flag values under a mutex
+    // so that concurrent updates from the event loop and from reader
+    // or writer threads cannot apply a stale mask last.
+    //
+    pthread_mutex_lock(&mEventMaskMutex);
+    EpollEventEngine::Instance().SetHandlerEvents(
+        mFileDescriptor,
+        ( ! mRxEventsPaused ) && ( ! mReaderThreadActive ),
+        mTxEventsEnabled ) ;
+    pthread_mutex_unlock(&mEventMaskMutex);
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::ResumeReadEventsIfNeeded()
+{
+    //
+    // If event delivery was paused because the input buffer was full,
+    // re-enable it now that space has been made in the buffer.
+    //
+    if ( mRxEventsPaused &&
+         ( mInputBuffer.GetSize() < mInputBuffer.GetCapacity() ) )
+    {
+        //
+        // The atomic exchange ensures that only one thread (this one
+        // or the event loop re-checking after a pause) resumes event
+        // delivery.
+        //
+        if ( mRxEventsPaused.exchange(false) )
+        {
+            this->UpdateHandlerEvents() ;
+        }
+    }
+    return ;
+}
+
+inline
+unsigned char
+SerialPort::SerialPortImpl::ReadByte(const unsigned int msTimeout)
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Wait for data to be available and then return the first byte,
+    // removing it from the buffer.
+    //
+    this->WaitForData( msTimeout ) ;
+
+    unsigned char next_char = 0 ;
+    mInputBuffer.PopByte( next_char ) ;
+    this->ResumeReadEventsIfNeeded() ;
+    return next_char ;
+}
+
+inline
+bool
+SerialPort::SerialPortImpl::TryReadByte( unsigned char&     dataByte,
+                                         const unsigned int msTimeout ) noexcept
+{
+    if ( ! this->IsOpen() )
+    {
+        return false ;
+    }
+    //
+    // Fast path: a byte is already buffered, so no waiting (and no
+    // unwinding) is needed at all.
+    //
+    if ( mInputBuffer.PopByte( dataByte ) )
+    {
+        this->ResumeReadEventsIfNeeded() ;
+        return true ;
+    }
+    if ( 0 != this->WaitForDataTimed( msTimeout ) )
+    {
+        return false ;
+    }
+    const bool byte_read = mInputBuffer.PopByte( dataByte ) ;
+    this->ResumeReadEventsIfNeeded() ;
+    return byte_read ;
+}
+
+inline
+std::error_code
+SerialPort::SerialPortImpl::TryRead( unsigned char*     dataBuffer,
+                                     const unsigned int numOfBytes,
+                                     const unsigned int msTimeout,
+                                     std::size_t&       numOfBytesRead ) noexcept
+{
+    numOfBytesRead = 0 ;
+    if ( ! this->IsOpen() )
+    {
+        return std::make_error_code( std::errc::not_connected ) ;
+    }
+    numOfBytesRead = mInputBuffer.Read( dataBuffer,
+                                        numOfBytes ) ;
+    this->ResumeReadEventsIfNeeded() ;
+    while( numOfBytesRead < numOfBytes )
+    {
+        const int wait_error = this->WaitForDataTimed( msTimeout ) ;
+        if ( 0 != wait_error )
+        {
+            return std::error_code( wait_error,
+                                    std::generic_category() ) ;
+        }
+        numOfBytesRead += mInputBuffer.Read( dataBuffer + numOfBytesRead,
+                                             numOfBytes - numOfBytesRead ) ;
+        this->ResumeReadEventsIfNeeded() ;
+    }
+    return std::error_code() ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::Read( SerialPort::DataBuffer& dataBuffer,
+                                  const unsigned int      numOfBytes,
+                                  const unsigned int      msTimeout )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Empty the data buffer.
+    //
+    dataBuffer.resize(0) ;
+    //
+    if ( 0 == numOfBytes )
+    {
+        //
+        // Read all available data if numOfBytes is zero.
+        //
+        std::size_t bytes_available = mInputBuffer.GetSize() ;
+        while( bytes_available > 0 )
+        {
+            const std::size_t old_size = dataBuffer.size() ;
+            dataBuffer.resize( old_size + bytes_available ) ;
+            mInputBuffer.Read( &dataBuffer[old_size],
+                               bytes_available ) ;
+            bytes_available = mInputBuffer.GetSize() ;
+        }
+    }
+    else
+    {
+        //
+        // Reserve enough space in the buffer to store the incoming
+        // data and then drain the input buffer in bulk, waiting only
+        // when it runs dry.
+        //
+        dataBuffer.reserve( numOfBytes ) ;
+        //
+        while( dataBuffer.size() < numOfBytes )
+        {
+            this->WaitForData( msTimeout ) ;
+
+            std::size_t bytes_to_copy = mInputBuffer.GetSize() ;
+            if ( bytes_to_copy > ( numOfBytes - dataBuffer.size() ) )
+            {
+                bytes_to_copy = numOfBytes - dataBuffer.size() ;
+            }
+            const std::size_t old_size = dataBuffer.size() ;
+            dataBuffer.resize( old_size + bytes_to_copy ) ;
+            mInputBuffer.Read( &dataBuffer[old_size],
+                               bytes_to_copy ) ;
+            this->ResumeReadEventsIfNeeded() ;
+        }
+    }
+    this->ResumeReadEventsIfNeeded() ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::Read( unsigned char*     dataBuffer,
+                                  const unsigned int numOfBytes,
+                                  const unsigned int msTimeout )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Copy data out of the input buffer in bulk, waiting only when
+    // the buffer runs dry. Each wait uses the full msTimeout value, in
+    // line with the per-byte timeout semantics of the other Read
+    // methods.
+    //
+    unsigned int bytes_read = mInputBuffer.Read( dataBuffer,
+                                                 numOfBytes ) ;
+    this->ResumeReadEventsIfNeeded() ;
+    while( bytes_read < numOfBytes )
+    {
+        this->WaitForData( msTimeout ) ;
+        bytes_read += mInputBuffer.Read( dataBuffer + bytes_read,
+                                         numOfBytes - bytes_read ) ;
+        this->ResumeReadEventsIfNeeded() ;
+    }
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::Read( unsigned char*               dataBuffer,
+                                  const unsigned int           numOfBytes,
+                                  const unsigned int           msTimeout,
+                                  SerialPort::RxTimestampList& timestamps )
+{
+    //
+    // Note the stream offset of the first byte this read will
+    // consume, perform a normal bulk read, and then collect the
+    // arrival records covering the consumed range.
+    //
+    const std::size_t range_start = mInputBuffer.GetTotalReadCount() ;
+    this->Read( dataBuffer,
+                numOfBytes,
+                msTimeout ) ;
+    timestamps.clear() ;
+    this->CollectRxTimestamps( range_start,
+                               range_start + numOfBytes,
+                               timestamps ) ;
+    return ;
+}
+
+inline
+std::size_t
+SerialPort::SerialPortImpl::ReadWithDeadline( unsigned char*     dataBuffer,
+                                              const std::size_t  maxNumOfBytes,
+                                              const unsigned int msTimeout )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Compute one absolute deadline for the entire call, so reading N
+    // bytes with a timeout of T milliseconds takes at most T
+    // milliseconds overall instead of applying T once per wait. The
+    // deadline is tracked with CLOCK_MONOTONIC so wall-clock steps do
+    // not shorten or extend it.
+    //
+    struct timespec deadline = { 0, 0 } ;
+    if ( msTimeout > 0 )
+    {
+        clock_gettime( CLOCK_MONOTONIC, &deadline ) ;
+        deadline.tv_sec  += msTimeout / 1000 ;
+        deadline.tv_nsec += ( msTimeout % 1000 ) * 1000000L ;
+        if ( deadline.tv_nsec >= 1000000000L )
+        {
+            deadline.tv_sec  += 1 ;
+            deadline.tv_nsec -= 1000000000L ;
+        }
+    }
+    std::size_t bytes_read = mInputBuffer.Read( dataBuffer,
+                                                maxNumOfBytes ) ;
+    this->ResumeReadEventsIfNeeded() ;
+    while( bytes_read < maxNumOfBytes )
+    {
+        unsigned int remaining_ms = 0 ;
+        if ( msTimeout > 0 )
+        {
+            struct timespec now ;
+            clock_gettime( CLOCK_MONOTONIC, &now ) ;
+            const long long remaining_ns =
+                ( deadline.tv_sec - now.tv_sec ) * 1000000000LL +
+                ( deadline.tv_nsec - now.tv_nsec ) ;
+            if ( remaining_ns <= 0 )
+            {
+                break ;
+            }
+            //
+            // Round up so that a wait is never truncated to zero
+            // milliseconds while time remains.
+            //
+            remaining_ms = ( remaining_ns + 999999 ) / 1000000 ;
+        }
+        const int wait_error = this->WaitForDataTimed( remaining_ms ) ;
+        if ( ETIMEDOUT == wait_error )
+        {
+            break ;
+        }
+        if ( 0 != wait_error )
+        {
+            throw std::runtime_error( strerror(wait_error) ) ;
+        }
+        bytes_read += mInputBuffer.Read( dataBuffer + bytes_read,
+                                         maxNumOfBytes - bytes_read ) ;
+        this->ResumeReadEventsIfNeeded() ;
+    }
+    //
+    // Return however many bytes arrived by the deadline; nothing that
+    // was received is ever discarded.
+    //
+    return bytes_read ;
+}
 
 inline
-bool
-SerialPort::SerialPortImpl::GetCts() const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+void
+SerialPort::SerialPortImpl::ConfigureDelimiterFraming( const unsigned char delimiter )
 {
-    return this->GetModemControlLine( TIOCM_CTS ) ;
-}    
+    mFramingMode    = SerialPort::FRAMING_DELIMITER ;
+    mFrameDelimiter = delimiter ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::ConfigureFixedLengthFraming( const std::size_t frameLength )
+{
+    if ( 0 == frameLength )
+    {
+        throw std::invalid_argument( ERR_MSG_INVALID_FRAME_LENGTH ) ;
+    }
+    mFramingMode = SerialPort::FRAMING_FIXED_LENGTH ;
+    mFrameLength = frameLength ;
+    return ;
+}
 
+inline
+void
+SerialPort::SerialPortImpl::ConfigureLengthPrefixFraming( const std::size_t prefixLength,
+                                                          const bool        bigEndian )
+{
+    if ( ( 1 != prefixLength ) &&
+         ( 2 != prefixLength ) &&
+         ( 4 != prefixLength ) )
+    {
+        throw std::invalid_argument( ERR_MSG_INVALID_PREFIX_LENGTH ) ;
+    }
+    mFramingMode          = SerialPort::FRAMING_LENGTH_PREFIX ;
+    mFramePrefixLength    = prefixLength ;
+    mFramePrefixBigEndian = bigEndian ;
+    return ;
+}
 
 inline
-bool
-SerialPort::SerialPortImpl::GetDsr() const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+void
+SerialPort::SerialPortImpl::DisableFraming()
 {
-    return this->GetModemControlLine( TIOCM_DSR ) ;
-}    
+    mFramingMode = SerialPort::FRAMING_NONE ;
+    return ;
+}
 
 inline
 void
-SerialPort::SerialPortImpl::SetModemControlLine( const int  modemLine,
-                                                 const bool lineState )
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+SerialPort::SerialPortImpl::ReadFrame( SerialPort::DataBuffer& frameBuffer,
+                                       const unsigned int      msTimeout )
+{
+    //
+    // Make sure that the serial port is open and a framing mode has
+    // been configured.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    if ( SerialPort::FRAMING_NONE == mFramingMode )
+    {
+        throw std::logic_error( ERR_MSG_NO_FRAMING_MODE ) ;
+    }
+    //
+    // Determine the length of the next complete frame by scanning the
+    // buffered data in bulk, waiting for more data while the frame is
+    // incomplete. Nothing is consumed until the whole frame is
+    // available, so a timeout leaves the partial frame in the buffer
+    // and the next call resumes where this one left off.
+    //
+    frameBuffer.resize(0) ;
+    while( true )
+    {
+        //
+        // Sample the fill level before scanning: if more data arrives
+        // while the scan runs, the wait below returns immediately and
+        // the frame is re-scanned.
+        //
+        const std::size_t buffered_size = mInputBuffer.GetSize() ;
+        std::size_t frame_length = 0 ;
+        switch( mFramingMode )
+        {
+        case SerialPort::FRAMING_DELIMITER:
+            {
+                std::size_t delimiter_position = 0 ;
+                if ( mInputBuffer.FindByte( mFrameDelimiter,
+                                            delimiter_position ) )
+                {
+                    frame_length = delimiter_position + 1 ;
+                }
+            }
+            break ;
+        case SerialPort::FRAMING_FIXED_LENGTH:
+            if ( mInputBuffer.GetSize() >= mFrameLength )
+            {
+                frame_length = mFrameLength ;
+            }
+            break ;
+        case SerialPort::FRAMING_LENGTH_PREFIX:
+            if ( mInputBuffer.GetSize() >= mFramePrefixLength )
+            {
+                //
+                // Peek at the length field without consuming it and
+                // check whether the whole payload has arrived yet.
+                //
+                unsigned char prefix_bytes[4] = { 0, 0, 0, 0 } ;
+                mInputBuffer.Peek( prefix_bytes,
+                                   mFramePrefixLength ) ;
+                std::size_t payload_length = 0 ;
+                for( std::size_t i = 0 ; i < mFramePrefixLength ; ++i )
+                {
+                    const std::size_t byte_index =
+                        mFramePrefixBigEndian ? ( mFramePrefixLength - 1 - i )
+                                              : i ;
+                    payload_length |=
+                        static_cast<std::size_t>(prefix_bytes[byte_index]) << ( 8 * i ) ;
+                }
+                //
+                // A frame that cannot fit in the input buffer can
+                // never be completed; fail fast (most likely a
+                // corrupt length field) instead of waiting forever.
+                // The comparison is arranged so that a corrupt length
+                // near SIZE_MAX cannot wrap the sum on 32-bit
+                // targets; the capacity is always larger than the
+                // prefix, so the subtraction is safe.
+                //
+                if ( payload_length >
+                     ( mInputBuffer.GetCapacity() - mFramePrefixLength ) )
+                {
+                    throw std::runtime_error(
+                        "Declared frame length exceeds the input buffer capacity." ) ;
+                }
+                if ( mInputBuffer.GetSize() >=
+                     ( mFramePrefixLength + payload_length ) )
+                {
+                    frame_length = mFramePrefixLength + payload_length ;
+                }
+            }
+            break ;
+        default:
+            throw std::logic_error( ERR_MSG_NO_FRAMING_MODE ) ;
+            break ;
+        }
+        if ( frame_length > 0 )
+        {
+            frameBuffer.resize( frame_length ) ;
+            mInputBuffer.Read( &frameBuffer[0],
+                               frame_length ) ;
+            this->ResumeReadEventsIfNeeded() ;
+            return ;
+        }
+        //
+        // The frame is still incomplete, so wait until more data than
+        // is currently buffered arrives (waiting merely for a
+        // non-empty buffer would spin while a partial frame sits in
+        // it).
+        //
+        const int wait_error =
+            this->WaitForMoreDataTimed( buffered_size,
+                                        msTimeout ) ;
+        if ( ETIMEDOUT == wait_error )
+        {
+            throw SerialPort::ReadTimeout() ;
+        }
+        if ( 0 != wait_error )
+        {
+            throw std::runtime_error( strerror(wait_error) ) ;
+        }
+    }
+}
+
+inline
+void
+SerialPort::SerialPortImpl::EnableRxTimestamping( const bool enabled )
+{
+    if ( enabled )
+    {
+        //
+        // Allocate the timestamp ring the first time timestamping is
+        // enabled; it stays allocated until the port is destroyed.
+        // The ring must be in place before the event loop can observe
+        // the enabled flag.
+        //
+        if ( 0 == mRxChunkRing )
+        {
+            mRxChunkRing = new RxChunkInfo[ RX_TIMESTAMP_RING_CAPACITY ] ;
+        }
+        mRxChunkTail.store( mRxChunkHead.load(std::memory_order_acquire),
+                            std::memory_order_release ) ;
+    }
+    mRxTimestampsEnabled.store( enabled,
+                                std::memory_order_release ) ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::StartCapture( const std::string& captureFilePath,
+                                          const std::size_t  maxFileSize )
+{
+    if ( mCaptureEnabled )
+    {
+        throw std::logic_error( "A capture is already in progress." ) ;
+    }
+    //
+    // Require room for the header page and a sensible amount of data.
+    //
+    if ( maxFileSize < ( CAPTURE_HEADER_SIZE + 4096 ) )
+    {
+        throw std::invalid_argument( "Capture file size is too small." ) ;
+    }
+    const std::size_t data_capacity = maxFileSize - CAPTURE_HEADER_SIZE ;
+    const int capture_fd = open( captureFilePath.c_str(),
+                                 O_RDWR | O_CREAT | O_TRUNC,
+                                 0644 ) ;
+    if ( capture_fd < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    if ( ftruncate( capture_fd,
+                    CAPTURE_HEADER_SIZE + data_capacity ) < 0 )
+    {
+        const int truncate_errno = errno ;
+        close( capture_fd ) ;
+        throw std::runtime_error( strerror(truncate_errno) ) ;
+    }
+    void* capture_mapping = mmap( 0,
+                                  CAPTURE_HEADER_SIZE + data_capacity,
+                                  PROT_READ | PROT_WRITE,
+                                  MAP_SHARED,
+                                  capture_fd,
+                                  0 ) ;
+    if ( MAP_FAILED == capture_mapping )
+    {
+        const int mmap_errno = errno ;
+        close( capture_fd ) ;
+        throw std::runtime_error( strerror(mmap_errno) ) ;
+    }
+    //
+    // Set up the mapping under the capture mutex and only then allow
+    // the RX path to start appending. Captured data reaches the file
+    // through the page cache; no msync is performed until the capture
+    // is stopped, so the per-chunk overhead is a memcpy.
+    //
+    pthread_mutex_lock(&mCaptureMutex);
+    mCaptureFileDescriptor = capture_fd ;
+    mCaptureMapping        = capture_mapping ;
+    mCaptureMappingSize    = CAPTURE_HEADER_SIZE + data_capacity ;
+    mCaptureHeader         = static_cast<CaptureFileHeader*>(capture_mapping) ;
+    mCaptureData           = static_cast<unsigned char*>(capture_mapping) +
+                             CAPTURE_HEADER_SIZE ;
+    std::memcpy( mCaptureHeader->magic,
+                 CAPTURE_FILE_MAGIC,
+                 sizeof(CAPTURE_FILE_MAGIC) ) ;
+    mCaptureHeader->dataCapacity = data_capacity ;
+    mCaptureHeader->headOffset   = 0 ;
+    mCaptureHeader->tailOffset   = 0 ;
+    pthread_mutex_unlock(&mCaptureMutex);
+    mCaptureEnabled.store( true,
+                           std::memory_order_release ) ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::StopCapture()
+{
+    if ( ! mCaptureEnabled.exchange(false) )
+    {
+        return ;
+    }
+    //
+    // Taking the capture mutex waits out any append in progress;
+    // afterwards the mapping can be flushed and released safely.
+    //
+    pthread_mutex_lock(&mCaptureMutex);
+    msync( mCaptureMapping,
+           mCaptureMappingSize,
+           MS_SYNC ) ;
+    munmap( mCaptureMapping,
+            mCaptureMappingSize ) ;
+    close( mCaptureFileDescriptor ) ;
+    mCaptureFileDescriptor = -1 ;
+    mCaptureMapping        = 0 ;
+    mCaptureMappingSize    = 0 ;
+    mCaptureHeader         = 0 ;
+    mCaptureData           = 0 ;
+    pthread_mutex_unlock(&mCaptureMutex);
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::CaptureWriteBytes( const uint64_t       offset,
+                                               const unsigned char* data,
+                                               const std::size_t    numOfBytes )
+{
+    const uint64_t data_capacity = mCaptureHeader->dataCapacity ;
+    const uint64_t write_index   = offset % data_capacity ;
+    const uint64_t bytes_till_end = data_capacity - write_index ;
+    if ( numOfBytes <= bytes_till_end )
+    {
+        std::memcpy( mCaptureData + write_index, data, numOfBytes ) ;
+    }
+    else
+    {
+        std::memcpy( mCaptureData + write_index, data, bytes_till_end ) ;
+        std::memcpy( mCaptureData, data + bytes_till_end,
+                     numOfBytes - bytes_till_end ) ;
+    }
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::CaptureChunk( const unsigned char*   data,
+                                          const std::size_t      numOfBytes,
+                                          const struct timespec& arrivalTime )
+{
+    pthread_mutex_lock(&mCaptureMutex);
+    if ( ( 0 == mCaptureHeader ) ||
+         ( ( CAPTURE_RECORD_HEADER_SIZE + numOfBytes ) >
+           mCaptureHeader->dataCapacity ) )
+    {
+        pthread_mutex_unlock(&mCaptureMutex);
+        return ;
+    }
+    //
+    // Evict whole records from the front of the ring until the new
+    // record fits.
+    //
+    const uint64_t record_size = CAPTURE_RECORD_HEADER_SIZE + numOfBytes ;
+    while( ( mCaptureHeader->headOffset + record_size -
+             mCaptureHeader->tailOffset ) > mCaptureHeader->dataCapacity )
+    {
+        uint32_t evicted_length = 0 ;
+        const uint64_t tail_index =
+            mCaptureHeader->tailOffset % mCaptureHeader->dataCapacity ;
+        for( std::size_t i = 0 ; i < sizeof(evicted_length) ; ++i )
+        {
+            reinterpret_cast<unsigned char*>(&evicted_length)[i] =
+                mCaptureData[ ( tail_index + i ) % mCaptureHeader->dataCapacity ] ;
+        }
+        mCaptureHeader->tailOffset +=
+            CAPTURE_RECORD_HEADER_SIZE + evicted_length ;
+    }
+    //
+    // Append the record header (payload length and arrival time)
+    // followed by the payload.
+    //
+    unsigned char record_header[CAPTURE_RECORD_HEADER_SIZE] ;
+    const uint32_t payload_length = numOfBytes ;
+    const uint64_t arrival_sec    = arrivalTime.tv_sec ;
+    const uint32_t arrival_nsec   = arrivalTime.tv_nsec ;
+    std::memcpy( record_header,      &payload_length, 4 ) ;
+    std::memcpy( record_header + 4,  &arrival_sec,    8 ) ;
+    std::memcpy( record_header + 12, &arrival_nsec,   4 ) ;
+    this->CaptureWriteBytes( mCaptureHeader->headOffset,
+                             record_header,
+                             sizeof(record_header) ) ;
+    this->CaptureWriteBytes( mCaptureHeader->headOffset +
+                             sizeof(record_header),
+                             data,
+                             numOfBytes ) ;
+    mCaptureHeader->headOffset += record_size ;
+    pthread_mutex_unlock(&mCaptureMutex);
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::CollectRxTimestamps( const std::size_t            rangeStart,
+                                                 const std::size_t            rangeEnd,
+                                                 SerialPort::RxTimestampList& timestamps )
+{
+    if ( ! mRxTimestampsEnabled.load(std::memory_order_relaxed) )
+    {
+        return ;
+    }
+    std::size_t chunk_tail = mRxChunkTail.load(std::memory_order_relaxed) ;
+    const std::size_t chunk_head = mRxChunkHead.load(std::memory_order_acquire) ;
+    while( chunk_tail != chunk_head )
+    {
+        const RxChunkInfo& chunk_info =
+            mRxChunkRing[ chunk_tail & ( RX_TIMESTAMP_RING_CAPACITY - 1 ) ] ;
+        const std::size_t chunk_end = chunk_info.startOffset + chunk_info.length ;
+        if ( chunk_end <= rangeStart )
+        {
+            //
+            // The record refers entirely to data consumed by an
+            // earlier, untimestamped read; discard it.
+            //
+            ++chunk_tail ;
+            continue ;
+        }
+        if ( chunk_info.startOffset >= rangeEnd )
+        {
+            //
+            // The record refers to data beyond this read; keep it for
+            // the next call.
+            //
+            break ;
+        }
+        //
+        // The record overlaps the consumed range: emit it clipped to
+        // the range, with the offset rebased to the start of the
+        // caller's buffer.
+        //
+        const std::size_t overlap_start =
+            ( chunk_info.startOffset > rangeStart ) ? chunk_info.startOffset
+                                                    : rangeStart ;
+        const std::size_t overlap_end =
+            ( chunk_end < rangeEnd ) ? chunk_end : rangeEnd ;
+
+        SerialPort::RxTimestamp timestamp_entry ;
+        timestamp_entry.byteOffset  = overlap_start - rangeStart ;
+        timestamp_entry.numOfBytes  = overlap_end - overlap_start ;
+        timestamp_entry.arrivalTime = chunk_info.arrivalTime ;
+        timestamps.push_back( timestamp_entry ) ;
+
+        if ( chunk_end <= rangeEnd )
+        {
+            //
+            // Fully consumed; remove the record from the ring.
+            //
+            ++chunk_tail ;
+        }
+        else
+        {
+            //
+            // The chunk extends beyond this read; its remainder will
+            // be reported by the next call.
+            //
+            break ;
+        }
+    }
+    mRxChunkTail.store( chunk_tail,
+                        std::memory_order_release ) ;
+    return ;
+}
+
+inline
+std::string
+SerialPort::SerialPortImpl::ReadLine( const unsigned int msTimeout,
+                                      const char         lineTerminator )
+{
+    //
+    // Returning a non-const string keeps the result movable, so the
+    // value lands in the caller's variable without a copy.
+    //
+    std::string result ;
+    this->ReadLine( result,
+                    msTimeout,
+                    lineTerminator ) ;
+    return result ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::ReadLine( std::string&       line,
+                                      const unsigned int msTimeout,
+                                      const char         lineTerminator )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // The line is assembled by scanning the input buffer for the
+    // terminator with memchr and copying whole chunks out, instead of
+    // paying the full wait machinery once per character. The caller's
+    // string is reused, so steady-state line reading does not allocate
+    // once the string has grown to the length of the longest line.
+    //
+    line.clear() ;
+    while( true )
+    {
+        //
+        // Sample the fill level before scanning: only bytes covered
+        // by the sample may be moved into the line on a scan miss.
+        // Bytes the event loop appends while the scan runs have not
+        // been checked for the terminator and must be left in the
+        // buffer for the next iteration, or a terminator among them
+        // would be swallowed into the middle of the line.
+        //
+        const std::size_t buffered_size = mInputBuffer.GetSize() ;
+        std::size_t terminator_position = 0 ;
+        if ( mInputBuffer.FindByte( lineTerminator,
+                                    terminator_position ) )
+        {
+            //
+            // Copy the line including the terminator out of the input
+            // buffer in one operation. Everything up to the
+            // terminator was scanned by FindByte itself, so this is
+            // safe even if the terminator lies beyond the sampled
+            // fill level.
+            //
+            const std::size_t old_size = line.size() ;
+            line.resize( old_size + terminator_position + 1 ) ;
+            mInputBuffer.Read(
+                reinterpret_cast<unsigned char*>(&line[old_size]),
+                terminator_position + 1 ) ;
+            this->ResumeReadEventsIfNeeded() ;
+            return ;
+        }
+        //
+        // No terminator among the scanned bytes: move exactly those
+        // bytes into the line.
+        //
+        if ( buffered_size > 0 )
+        {
+            const std::size_t old_size = line.size() ;
+            line.resize( old_size + buffered_size ) ;
+            mInputBuffer.Read(
+                reinterpret_cast<unsigned char*>(&line[old_size]),
+                buffered_size ) ;
+            this->ResumeReadEventsIfNeeded() ;
+        }
+        //
+        // If data arrived during the scan it is still unscanned;
+        // rescan it right away instead of waiting.
+        //
+        if ( ! mInputBuffer.IsEmpty() )
+        {
+            continue ;
+        }
+        this->WaitForData( msTimeout ) ;
+    }
+}
+
+inline
+void
+SerialPort::SerialPortImpl::ReadLineIncremental( std::string&       line,
+                                                 const unsigned int msTimeout,
+                                                 const char         lineTerminator )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Unlike ReadLine, nothing is consumed from the input buffer
+    // until the terminator has been found: a timeout leaves the
+    // partial line buffered, and the next call resumes accumulating
+    // the very same line. The fill level is sampled before each scan
+    // so data arriving during the scan wakes the wait immediately.
+    //
+    line.clear() ;
+    while( true )
+    {
+        const std::size_t buffered_size = mInputBuffer.GetSize() ;
+        std::size_t terminator_position = 0 ;
+        if ( mInputBuffer.FindByte( lineTerminator,
+                                    terminator_position ) )
+        {
+            line.resize( terminator_position + 1 ) ;
+            mInputBuffer.Read(
+                reinterpret_cast<unsigned char*>(&line[0]),
+                terminator_position + 1 ) ;
+            this->ResumeReadEventsIfNeeded() ;
+            return ;
+        }
+        const int wait_error =
+            this->WaitForMoreDataTimed( buffered_size,
+                                        msTimeout ) ;
+        if ( ETIMEDOUT == wait_error )
+        {
+            throw SerialPort::ReadTimeout() ;
+        }
+        if ( 0 != wait_error )
+        {
+            throw std::runtime_error( strerror(wait_error) ) ;
+        }
+    }
+}
+
+inline
+void
+SerialPort::SerialPortImpl::WriteByte( const unsigned char dataByte )
+{
+    //
+    // Make sure that the serial port is open.
+    //
+    if ( ! this->IsOpen() )
+    {
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+    }
+    //
+    // Write the byte to the serial port.
+    //
+    this->Write( &dataByte,
+                 1 ) ;
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::Write(const SerialPort::DataBuffer& dataBuffer)
 {
     //
     // Make sure that the serial port is open.
@@ -1285,75 +3645,94 @@ SerialPort::SerialPortImpl::SetModemControlLine( const int  modemLine,
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // :TODO: Check to make sure that modemLine is a valid value.
-    // 
-    // Set or unset the specified bit according to the value of
-    // lineState.
+    // Nothing needs to be done if there is no data in the buffer.
     //
-    int ioctl_result = -1 ;
-    if ( true == lineState )
-    {
-        int set_line_mask = modemLine ;
-        ioctl_result = ioctl( mFileDescriptor, 
-                              TIOCMBIS,
-                              &set_line_mask ) ;
-    }
-    else
+    if ( 0 == dataBuffer.size() )
     {
-        int reset_line_mask = modemLine ;
-        ioctl_result = ioctl( mFileDescriptor, 
-                              TIOCMBIC,
-                              &reset_line_mask ) ;
+        return ;
     }
     //
-    // Check for errors. 
+    // The storage of a std::vector is contiguous, so the data can be
+    // written directly from the buffer without copying it into
+    // separately allocated memory first.
     //
-    if ( -1 == ioctl_result )
-    {
-        throw std::runtime_error( strerror(errno) ) ;
-    }
+    this->Write( &dataBuffer[0],
+                 dataBuffer.size() ) ;
     return ;
 }
 
 inline
-bool
-SerialPort::SerialPortImpl::GetModemControlLine( const int modemLine ) const
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+std::error_code
+SerialPort::SerialPortImpl::TryWrite( const unsigned char* dataBuffer,
+                                      const unsigned int   bufferSize ) noexcept
 {
-    //
-    // Make sure that the serial port is open.
-    //
     if ( ! this->IsOpen() )
     {
-        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+        return std::make_error_code( std::errc::not_connected ) ;
     }
     //
-    // Use an ioctl() call to get the state of the line.
+    // Write the data to the serial port. The port is kept in
+    // non-blocking mode for the event engine, so a write may be
+    // accepted only partially or rejected with EAGAIN when the output
+    // buffer is full; in both cases wait with poll() until the port
+    // becomes writable again instead of busy-retrying.
     //
-    int serial_port_state = 0 ;
-    if ( -1 == ioctl( mFileDescriptor,
-                      TIOCMGET,
-                      &serial_port_state ) )
+    unsigned int num_of_bytes_written = 0 ;
+    while( num_of_bytes_written < bufferSize )
     {
-        throw std::runtime_error( strerror(errno) ) ;
+        const ssize_t write_result = write( mFileDescriptor,
+                                            dataBuffer + num_of_bytes_written,
+                                            bufferSize - num_of_bytes_written ) ;
+        mStatWriteSyscalls.fetch_add(1, std::memory_order_relaxed) ;
+        if ( write_result >= 0 )
+        {
+            mStatBytesTransmitted.fetch_add(write_result, std::memory_order_relaxed) ;
+            num_of_bytes_written += write_result ;
+            continue ;
+        }
+        if ( EAGAIN != errno )
+        {
+            return std::error_code( errno,
+                                    std::generic_category() ) ;
+        }
+        struct pollfd poll_info ;
+        poll_info.fd      = mFileDescriptor ;
+        poll_info.events  = POLLOUT ;
+        poll_info.revents = 0 ;
+        if ( ( poll( &poll_info,
+                     1,
+                     -1 ) < 0 ) &&
+             ( EINTR != errno ) )
+        {
+            return std::error_code( errno,
+                                    std::generic_category() ) ;
+        }
     }
-    //
-    // :TODO: Verify that modemLine is a valid value.
-    //
-    return ( serial_port_state & modemLine ) ;
+    return std::error_code() ;
 }
 
 inline
-unsigned char
-SerialPort::SerialPortImpl::ReadByte(const unsigned int msTimeout)
-    throw( SerialPort::NotOpen,
-           SerialPort::ReadTimeout,
-           std::runtime_error )
+void
+SerialPort::SerialPortImpl::Write( const unsigned char* dataBuffer,
+                                   const unsigned int   bufferSize )
+{
+    const std::error_code write_error = this->TryWrite( dataBuffer,
+                                                        bufferSize ) ;
+    if ( write_error )
+    {
+        if ( std::errc::not_connected == write_error )
+        {
+            throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
+        }
+        throw std::runtime_error( write_error.message() ) ;
+    }
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::WriteGather( const SerialPort::GatherBuffer& gatherBuffer )
 {
-	pthread_mutex_lock(&mQueueMutex);
-	int queueSize = mInputBuffer.size();
-	pthread_mutex_unlock(&mQueueMutex);
     //
     // Make sure that the serial port is open.
     //
@@ -1362,146 +3741,287 @@ SerialPort::SerialPortImpl::ReadByte(const unsigned int msTimeout)
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Get the current time. Throw an exception if we are unable
-    // to read the current time.
+    // Describe the caller's buffers with an iovec array so that all of
+    // them can be handed to the kernel with a single writev() call,
+    // without assembling them into a temporary buffer first.
     //
-    struct timeval entry_time ;
-    if ( gettimeofday( &entry_time,
-                       NULL ) < 0 )
+    std::vector<struct iovec> io_vector ;
+    io_vector.reserve( gatherBuffer.size() ) ;
+    for( SerialPort::GatherBuffer::const_iterator buffer_iterator = gatherBuffer.begin() ;
+         buffer_iterator != gatherBuffer.end() ;
+         ++buffer_iterator )
     {
-        throw std::runtime_error( strerror(errno) ) ;
+        if ( 0 == buffer_iterator->second )
+        {
+            continue ;
+        }
+        struct iovec io_entry ;
+        io_entry.iov_base = const_cast<unsigned char*>( buffer_iterator->first ) ;
+        io_entry.iov_len  = buffer_iterator->second ;
+        io_vector.push_back( io_entry ) ;
     }
     //
-    // Wait for data to be available.
+    // Write the buffers to the serial port. As with Write(), a short
+    // or rejected write makes us wait with poll() until the port
+    // becomes writable and continue where the kernel stopped.
     //
-    const int MICROSECONDS_PER_MS  = 1000 ;
-    const int MILLISECONDS_PER_SEC = 1000 ;
-
-    while(queueSize == 0 )
+    std::size_t current_entry = 0 ;
+    while( current_entry < io_vector.size() )
     {
-        //
-        // Read the current time.
-        //
-        struct timeval curr_time ;
-        if ( gettimeofday( &curr_time,
-                           NULL ) < 0 )
+        std::size_t entries_to_write = io_vector.size() - current_entry ;
+        if ( entries_to_write > IOV_MAX )
         {
-            throw std::runtime_error( strerror(errno) ) ;
+            entries_to_write = IOV_MAX ;
         }
-        //
-        // Obtain the elapsed time.
-        //
-        struct timeval elapsed_time = curr_time - entry_time ;
-        //
-        // Increase the elapsed number of milliseconds.
-        //
-        int elapsed_ms = ( elapsed_time.tv_sec  * MILLISECONDS_PER_SEC +
-                           elapsed_time.tv_usec / MICROSECONDS_PER_MS ) ;
-        //
-        // If more than msTimeout milliseconds have elapsed while
-        // waiting for data, then we throw a ReadTimeout exception.
-        //
-        if ( ( msTimeout > 0 ) &&
-             ( elapsed_ms > (int)msTimeout ) )
+        ssize_t bytes_written = writev( mFileDescriptor,
+                                        &io_vector[current_entry],
+                                        entries_to_write ) ;
+        if ( bytes_written < 0 )
         {
-            throw SerialPort::ReadTimeout() ;
+            if ( EAGAIN != errno )
+            {
+                throw std::runtime_error( strerror(errno) ) ;
+            }
+            struct pollfd poll_info ;
+            poll_info.fd      = mFileDescriptor ;
+            poll_info.events  = POLLOUT ;
+            poll_info.revents = 0 ;
+            if ( ( poll( &poll_info,
+                         1,
+                         -1 ) < 0 ) &&
+                 ( EINTR != errno ) )
+            {
+                throw std::runtime_error( strerror(errno) ) ;
+            }
+            continue ;
         }
         //
-        // Wait for 1ms (1000us) for data to arrive.
+        // Skip the entries that were written completely and adjust the
+        // first partially written entry.
         //
-        usleep( MICROSECONDS_PER_MS ) ;
-        pthread_mutex_lock(&mQueueMutex);
-		queueSize = mInputBuffer.size();
-		pthread_mutex_unlock(&mQueueMutex);
+        while( ( bytes_written > 0 ) &&
+               ( static_cast<std::size_t>(bytes_written) >=
+                 io_vector[current_entry].iov_len ) )
+        {
+            bytes_written -= io_vector[current_entry].iov_len ;
+            ++current_entry ;
+        }
+        if ( bytes_written > 0 )
+        {
+            io_vector[current_entry].iov_base =
+                static_cast<unsigned char*>( io_vector[current_entry].iov_base ) +
+                bytes_written ;
+            io_vector[current_entry].iov_len -= bytes_written ;
+        }
     }
+    return ;
+}
+
+inline
+unsigned int
+SerialPort::SerialPortImpl::WriteAsync( const unsigned char* dataBuffer,
+                                        const unsigned int   bufferSize )
+{
     //
-    // Return the first byte and remove it from the queue.
+    // Make sure that the serial port is open.
     //
-    pthread_mutex_lock(&mQueueMutex);
-    unsigned char next_char = mInputBuffer.front() ;
-    mInputBuffer.pop() ;
-
-    //Updating flag if queue is empty by now
-    if ( mInputBuffer.size() == 0)
+    if ( ! this->IsOpen() )
     {
-    	mIsQueueDataAvailable = false;
+        throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
-    pthread_mutex_unlock(&mQueueMutex);
-
-    return next_char ;
+    //
+    // Store as much of the data as fits into the write queue and
+    // enable write events for the port so that the event loop drains
+    // the queue as the port accepts data. The caller gets back the
+    // number of bytes accepted and never blocks on the line speed.
+    //
+    const unsigned int bytes_queued = mOutputBuffer.Write( dataBuffer,
+                                                           bufferSize ) ;
+    if ( bytes_queued > 0 )
+    {
+        if ( ! mTxEventsEnabled.exchange(true) )
+        {
+            this->UpdateHandlerEvents() ;
+        }
+    }
+    return bytes_queued ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::Read( SerialPort::DataBuffer& dataBuffer,
-                                  const unsigned int      numOfBytes,
-                                  const unsigned int      msTimeout )
-    throw( SerialPort::NotOpen,
-           SerialPort::ReadTimeout,
-           std::runtime_error )
+SerialPort::SerialPortImpl::ReadAsync( const std::size_t        numOfBytes,
+                                       SerialPort::ReadCallback callback )
 {
     //
-    // Make sure that the serial port is open.
+    // Make sure that the serial port is open and the request is
+    // meaningful.
     //
     if ( ! this->IsOpen() )
     {
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
+    if ( ( 0 == numOfBytes ) ||
+         ( ! callback ) )
+    {
+        throw std::invalid_argument( "Invalid asynchronous read request." ) ;
+    }
+    pthread_mutex_lock(&mAsyncRequestMutex);
+    PendingAsyncRead pending_read ;
+    pending_read.numOfBytes = numOfBytes ;
+    pending_read.callback   = std::move(callback) ;
+    mPendingReads.push_back( std::move(pending_read) ) ;
+    pthread_mutex_unlock(&mAsyncRequestMutex);
     //
-    // Empty the data buffer.
-    //
-    dataBuffer.resize(0) ;
+    // Complete the request right away if the data is already
+    // buffered.
     //
-    if ( 0 == numOfBytes )
+    this->ServicePendingReads() ;
+    return ;
+}
+
+inline
+unsigned int
+SerialPort::SerialPortImpl::WriteAsync( const unsigned char*      dataBuffer,
+                                        const unsigned int        bufferSize,
+                                        SerialPort::WriteCallback callback )
+{
+    const unsigned int bytes_queued = this->WriteAsync( dataBuffer,
+                                                        bufferSize ) ;
+    if ( callback )
     {
+        pthread_mutex_lock(&mAsyncRequestMutex);
+        PendingAsyncWrite pending_write ;
+        pending_write.completionOffset = mOutputBuffer.GetTotalWriteCount() ;
+        pending_write.callback         = std::move(callback) ;
+        mPendingWrites.push_back( std::move(pending_write) ) ;
+        pthread_mutex_unlock(&mAsyncRequestMutex);
         //
-        // Read all available data if numOfBytes is zero.
+        // The event loop may have drained the queue (and stopped
+        // looking at the completion list) before the entry above was
+        // registered; deliver it here in that case.
         //
-        while( this->IsDataAvailable() )
-        {
-            dataBuffer.push_back( ReadByte(msTimeout) ) ;
-        }
+        this->ServicePendingWrites() ;
     }
-    else
+    return bytes_queued ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::ServicePendingReads()
+{
+    //
+    // Requests are completed strictly in issue order: the delivery
+    // mutex is held across the callback invocation, so a concurrent
+    // service pass from another thread cannot run a later request's
+    // callback before an earlier one that has been popped but not yet
+    // invoked. The request mutex is still released around the
+    // callback so a callback can issue further requests; such a
+    // nested (or concurrent) call fails the trylock and relies on the
+    // running delivery loop, which re-checks the queue after every
+    // callback and again before returning.
+    //
+    while( true )
     {
+        if ( pthread_mutex_trylock(&mCompletionDeliveryMutex) != 0 )
+        {
+            return ;
+        }
+        while( true )
+        {
+            SerialPort::ReadCallback callback ;
+            SerialPort::DataBuffer   data_buffer ;
+
+            pthread_mutex_lock(&mAsyncRequestMutex);
+            if ( mPendingReads.empty() ||
+                 ( mInputBuffer.GetSize() < mPendingReads.front().numOfBytes ) )
+            {
+                pthread_mutex_unlock(&mAsyncRequestMutex);
+                break ;
+            }
+            data_buffer.resize( mPendingReads.front().numOfBytes ) ;
+            mInputBuffer.Read( &data_buffer[0],
+                               data_buffer.size() ) ;
+            callback = std::move( mPendingReads.front().callback ) ;
+            mPendingReads.pop_front() ;
+            pthread_mutex_unlock(&mAsyncRequestMutex);
+
+            this->ResumeReadEventsIfNeeded() ;
+            callback( data_buffer ) ;
+        }
+        pthread_mutex_unlock(&mCompletionDeliveryMutex);
         //
-        // Reserve enough space in the buffer to store the incoming
-        // data.
-        //
-        dataBuffer.reserve( numOfBytes ) ;
+        // A request that became satisfiable while the delivery mutex
+        // was still held may have been skipped by its issuer's failed
+        // trylock; re-check here so it is delivered now rather than
+        // on the next event.
         //
-        for(unsigned int i=0; i<numOfBytes; ++i)
+        pthread_mutex_lock(&mAsyncRequestMutex);
+        const bool more_deliverable =
+            ( ! mPendingReads.empty() ) &&
+            ( mInputBuffer.GetSize() >= mPendingReads.front().numOfBytes ) ;
+        pthread_mutex_unlock(&mAsyncRequestMutex);
+        if ( ! more_deliverable )
         {
-            dataBuffer.push_back( ReadByte(msTimeout) ) ;
+            return ;
         }
     }
-    return ;
 }
 
 inline
-const std::string
-SerialPort::SerialPortImpl::ReadLine( const unsigned int msTimeout,
-                                      const char         lineTerminator )
-    throw( SerialPort::NotOpen,
-           SerialPort::ReadTimeout,
-           std::runtime_error )
+void
+SerialPort::SerialPortImpl::ServicePendingWrites()
 {
-    std::string result ;
-    char next_char = 0 ;
-    do
+    //
+    // See ServicePendingReads for the delivery-ordering scheme.
+    //
+    while( true )
     {
-        next_char = this->ReadByte( msTimeout ) ;
-        result += next_char ;
+        if ( pthread_mutex_trylock(&mCompletionDeliveryMutex) != 0 )
+        {
+            return ;
+        }
+        while( true )
+        {
+            SerialPort::WriteCallback callback ;
+
+            pthread_mutex_lock(&mAsyncRequestMutex);
+            if ( mPendingWrites.empty() ||
+                 ( mOutputBuffer.GetTotalReadCount() <
+                   mPendingWrites.front().completionOffset ) )
+            {
+                pthread_mutex_unlock(&mAsyncRequestMutex);
+                break ;
+            }
+            callback = std::move( mPendingWrites.front().callback ) ;
+            mPendingWrites.pop_front() ;
+            pthread_mutex_unlock(&mAsyncRequestMutex);
+
+            callback() ;
+        }
+        pthread_mutex_unlock(&mCompletionDeliveryMutex);
+        pthread_mutex_lock(&mAsyncRequestMutex);
+        const bool more_deliverable =
+            ( ! mPendingWrites.empty() ) &&
+            ( mOutputBuffer.GetTotalReadCount() >=
+              mPendingWrites.front().completionOffset ) ;
+        pthread_mutex_unlock(&mAsyncRequestMutex);
+        if ( ! more_deliverable )
+        {
+            return ;
+        }
     }
-    while( next_char != lineTerminator ) ;
-    return result ;
 }
 
 inline
-void
-SerialPort::SerialPortImpl::WriteByte( const unsigned char dataByte )
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+std::size_t
+SerialPort::SerialPortImpl::GetAsyncWriteQueueSize() const
+{
+    return mOutputBuffer.GetSize() ;
+}
+
+inline
+std::size_t
+SerialPort::SerialPortImpl::GetOutputQueueByteCount() const
 {
     //
     // Make sure that the serial port is open.
@@ -1510,19 +4030,19 @@ SerialPort::SerialPortImpl::WriteByte( const unsigned char dataByte )
     {
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
-    //
-    // Write the byte to the serial port.
-    //
-    this->Write( &dataByte,
-                 1 ) ;
-    return ;
+    int num_of_bytes_queued = 0 ;
+    if ( ioctl( mFileDescriptor,
+                TIOCOUTQ,
+                &num_of_bytes_queued ) < 0 )
+    {
+        throw std::runtime_error( strerror(errno) ) ;
+    }
+    return num_of_bytes_queued ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::Write(const SerialPort::DataBuffer& dataBuffer)
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+SerialPort::SerialPortImpl::DrainWriteBuffer( const unsigned int msTimeout )
 {
     //
     // Make sure that the serial port is open.
@@ -1532,59 +4052,53 @@ SerialPort::SerialPortImpl::Write(const SerialPort::DataBuffer& dataBuffer)
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Nothing needs to be done if there is no data in the buffer.
-    //
-    if ( 0 == dataBuffer.size() )
-    {
-        return ;
-    }
-    //
-    // Allocate memory for storing the contents of the
-    // dataBuffer. This allows us to write all the data using a single
-    // call to write() instead of writing one byte at a time.
+    // Track one overall CLOCK_MONOTONIC deadline across all three
+    // stages of the drain.
     //
-    unsigned char* local_buffer = new unsigned char[dataBuffer.size()] ;
-    if ( 0 == local_buffer )
+    struct timespec deadline = { 0, 0 } ;
+    if ( msTimeout > 0 )
     {
-        throw std::runtime_error( std::string(__FUNCTION__) +
-                                  ": Cannot allocate memory while writing"
-                                  "data to the serial port." ) ;
+        clock_gettime( CLOCK_MONOTONIC, &deadline ) ;
+        deadline.tv_sec  += msTimeout / 1000 ;
+        deadline.tv_nsec += ( msTimeout % 1000 ) * 1000000L ;
+        if ( deadline.tv_nsec >= 1000000000L )
+        {
+            deadline.tv_sec  += 1 ;
+            deadline.tv_nsec -= 1000000000L ;
+        }
     }
     //
-    // Copy the data into local_buffer.
-    //
-    std::copy( dataBuffer.begin(),
-               dataBuffer.end(),
-               local_buffer ) ;
-    //
-    // Write data to the serial port.
+    // Stage one: wait for the asynchronous write queue to be handed
+    // to the kernel. Stage two: poll the kernel output queue until it
+    // is empty. Stage three: tcdrain() for the transmitter FIFO,
+    // which returns quickly once the output queue is empty.
     //
-    try
+    while( ( ! mOutputBuffer.IsEmpty() ) ||
+           ( this->GetOutputQueueByteCount() > 0 ) )
     {
-        this->Write( local_buffer,
-                     dataBuffer.size() ) ;
+        if ( msTimeout > 0 )
+        {
+            struct timespec now ;
+            clock_gettime( CLOCK_MONOTONIC, &now ) ;
+            if ( ( ( now.tv_sec - deadline.tv_sec ) * 1000000000LL +
+                   ( now.tv_nsec - deadline.tv_nsec ) ) >= 0 )
+            {
+                mStatWriteTimeouts.fetch_add(1, std::memory_order_relaxed) ;
+                throw SerialPort::WriteTimeout() ;
+            }
+        }
+        usleep(500) ;
     }
-    catch( ... )
+    if ( tcdrain( mFileDescriptor ) < 0 )
     {
-        //
-        // Free the allocated memory.
-        //
-        delete [] local_buffer ;
-        throw ;
+        throw std::runtime_error( strerror(errno) ) ;
     }
-    //
-    // Free the allocated memory.
-    //
-    delete [] local_buffer ;
     return ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::Write( const unsigned char* dataBuffer,
-                                   const unsigned int   bufferSize )
-    throw( SerialPort::NotOpen,
-           std::runtime_error )
+SerialPort::SerialPortImpl::WaitForAsyncWrites( const unsigned int msTimeout )
 {
     //
     // Make sure that the serial port is open.
@@ -1594,40 +4108,44 @@ SerialPort::SerialPortImpl::Write( const unsigned char* dataBuffer,
         throw SerialPort::NotOpen( ERR_MSG_PORT_NOT_OPEN ) ;
     }
     //
-    // Write the data to the serial port. Keep retrying if EAGAIN
-    // error is received.
-    //
-    int num_of_bytes_written = -1 ;
-    do
-    {
-        num_of_bytes_written = write( mFileDescriptor,
-                                      dataBuffer,
-                                      bufferSize ) ;
-    }
-    while ( ( num_of_bytes_written < 0 ) &&
-            ( EAGAIN == errno ) ) ;
+    // Compute the absolute deadline at which the wait must give up
+    // and wait for the event loop to signal that the write queue has
+    // been drained. The queue state is re-checked after every wakeup
+    // as the semaphore may carry posts from earlier drains.
     //
-    if ( num_of_bytes_written < 0 )
+    const struct timespec deadline = ComputeDeadline( msTimeout ) ;
+    while( ! mOutputBuffer.IsEmpty() )
     {
-        throw std::runtime_error( strerror(errno) ) ;
+        int wait_result = 0 ;
+        if ( 0 == msTimeout )
+        {
+            wait_result = sem_wait( &mTxDrainedSemaphore ) ;
+        }
+        else
+        {
+            wait_result = sem_timedwait( &mTxDrainedSemaphore,
+                                         &deadline ) ;
+        }
+        if ( wait_result < 0 )
+        {
+            if ( ETIMEDOUT == errno )
+            {
+                mStatWriteTimeouts.fetch_add(1, std::memory_order_relaxed) ;
+                throw SerialPort::WriteTimeout() ;
+            }
+            if ( EINTR != errno )
+            {
+                throw std::runtime_error( strerror(errno) ) ;
+            }
+        }
     }
-    //
-    // :FIXME: What happens if num_of_bytes_written < bufferSize ?
-    //
     return ;
 }
 
 inline
 void
-SerialPort::SerialPortImpl::HandlePosixSignal( int signalNumber )
+SerialPort::SerialPortImpl::HandleReadEvent()
 {
-    //
-    // We only want to deal with SIGIO signals here.
-    //
-    if ( SIGIO != signalNumber )
-    {
-        return ;
-    }
     //
     // Check if any data is available at the specified file
     // descriptor.
@@ -1643,100 +4161,220 @@ SerialPort::SerialPortImpl::HandlePosixSignal( int signalNumber )
         return ;
     }
 
-    //Try to get the mutex
-    if (pthread_mutex_trylock(&mQueueMutex) == 0)
-    {
-    	// First of all, any pending data within the mShadowInputBuffer
-    	// must be transfered into the regular buffer.
-    	while(!mShadowInputBuffer.empty())
-		{
-    		//Transfering to actual input buffer
-    		mInputBuffer.push(mShadowInputBuffer.front());
-    		//Removing from shadow buffer
-    		mShadowInputBuffer.pop();
-		}
-
-		//
-		// If data is available, read all available data and shove
-		// it into the corresponding input buffer.
-		//
-		for(int i=0; i<num_of_bytes_available; ++i)
-		{
-			unsigned char next_byte ;
-			if ( read( mFileDescriptor,
-					   &next_byte,
-					   1 ) > 0 )
-			{
-				mInputBuffer.push( next_byte );
-			}
-			else
-			{
-				//Updating flag
-				pthread_mutex_unlock(&mQueueMutex);
-				break ;
-			}
-		}
-
-		//Updating flag
-		mIsQueueDataAvailable = true;
-
-		//Release the mutex
-		pthread_mutex_unlock(&mQueueMutex);
-    } else {
-    	//Mutex is locked - using shadowQueue to avoid a deadlock!
-    	//
-		// If data is available, read all available data and shove
-		// it temporarily into the shadow buffer.
-		//
-		for(int i=0; i<num_of_bytes_available; ++i)
-		{
-			unsigned char next_byte ;
-			if ( read( mFileDescriptor,
-					   &next_byte,
-					   1 ) > 0 )
-			{
-				mShadowInputBuffer.push( next_byte );
-			}
-			else
-			{
-				break ;
-			}
-		}
+    //
+    // If data is available, drain it from the tty input buffer with
+    // bulk read() calls and store each chunk into the input buffer
+    // with a single ring-buffer operation, instead of paying one
+    // syscall and one buffer operation per byte. If the ring buffer
+    // fills up, event delivery for the port is paused (leaving the
+    // remaining data in the tty's input buffer so that the kernel can
+    // apply flow control) and resumed by the read methods once they
+    // have made space; otherwise the level-triggered event loop would
+    // spin on the port.
+    //
+    bool data_stored = false ;
+    unsigned char read_chunk[RX_READ_CHUNK_SIZE] ;
+    while( num_of_bytes_available > 0 )
+    {
+        //
+        // Read no more than the free space in the ring buffer and no
+        // more than one chunk at a time.
+        //
+        std::size_t bytes_to_read =
+            mInputBuffer.GetCapacity() - mInputBuffer.GetSize() ;
+        if ( 0 == bytes_to_read )
+        {
+            mStatRxPauseEvents.fetch_add(1, std::memory_order_relaxed) ;
+            mRxEventsPaused = true ;
+            this->UpdateHandlerEvents() ;
+            //
+            // The reading thread may have drained the buffer between
+            // the fullness check above and the pause taking effect
+            // without observing mRxEventsPaused. Re-check here and
+            // resume immediately if space is available again so that
+            // event delivery cannot stall with data pending.
+            //
+            if ( mInputBuffer.GetSize() < mInputBuffer.GetCapacity() )
+            {
+                this->ResumeReadEventsIfNeeded() ;
+                continue ;
+            }
+            break ;
+        }
+        if ( bytes_to_read > sizeof(read_chunk) )
+        {
+            bytes_to_read = sizeof(read_chunk) ;
+        }
+        if ( bytes_to_read > static_cast<std::size_t>(num_of_bytes_available) )
+        {
+            bytes_to_read = num_of_bytes_available ;
+        }
+        const ssize_t bytes_read = read( mFileDescriptor,
+                                         read_chunk,
+                                         bytes_to_read ) ;
+        mStatReadSyscalls.fetch_add(1, std::memory_order_relaxed) ;
+        if ( bytes_read <= 0 )
+        {
+            break ;
+        }
+        mStatBytesReceived.fetch_add(bytes_read, std::memory_order_relaxed) ;
+        const std::size_t chunk_offset = mInputBuffer.GetTotalWriteCount() ;
+        mInputBuffer.Write( read_chunk,
+                            bytes_read ) ;
+        //
+        // Track the deepest fill level of the input buffer. The event
+        // loop is the only writer of this value, so a plain
+        // compare-and-store suffices.
+        //
+        const std::size_t buffer_fill_level = mInputBuffer.GetSize() ;
+        if ( buffer_fill_level >
+             mStatRxHighWatermark.load(std::memory_order_relaxed) )
+        {
+            mStatRxHighWatermark.store( buffer_fill_level,
+                                        std::memory_order_relaxed ) ;
+        }
+        //
+        // Record the arrival time of the chunk - one clock read per
+        // chunk, not per byte - if timestamping is enabled and the
+        // timestamp ring has room.
+        //
+        if ( mRxTimestampsEnabled.load(std::memory_order_relaxed) )
+        {
+            const std::size_t chunk_head =
+                mRxChunkHead.load(std::memory_order_relaxed) ;
+            const std::size_t chunk_tail =
+                mRxChunkTail.load(std::memory_order_acquire) ;
+            if ( ( chunk_head - chunk_tail ) < RX_TIMESTAMP_RING_CAPACITY )
+            {
+                RxChunkInfo& chunk_info =
+                    mRxChunkRing[ chunk_head & ( RX_TIMESTAMP_RING_CAPACITY - 1 ) ] ;
+                chunk_info.startOffset = chunk_offset ;
+                chunk_info.length      = bytes_read ;
+                clock_gettime( CLOCK_MONOTONIC,
+                               &chunk_info.arrivalTime ) ;
+                mRxChunkHead.store( chunk_head + 1,
+                                    std::memory_order_release ) ;
+            }
+        }
+        if ( mCaptureEnabled.load(std::memory_order_relaxed) )
+        {
+            struct timespec arrival_time ;
+            clock_gettime( CLOCK_MONOTONIC,
+                           &arrival_time ) ;
+            this->CaptureChunk( read_chunk,
+                                bytes_read,
+                                arrival_time ) ;
+        }
+        data_stored = true ;
+        num_of_bytes_available -= bytes_read ;
+    }
+
+    //Wake up any thread waiting in ReadByte for data to arrive, and
+    //any SerialPortGroup waiting on this port
+    if ( data_stored )
+    {
+        sem_post(&mDataAvailableSemaphore);
+        sem_t* data_event_semaphore =
+            mDataEventSemaphore.load(std::memory_order_relaxed) ;
+        if ( 0 != data_event_semaphore )
+        {
+            sem_post(data_event_semaphore);
+        }
+        this->ServicePendingReads() ;
+    }
+    return ;
+}
+
+inline
+void
+SerialPort::SerialPortImpl::HandleWriteEvent()
+{
+    //
+    // Drain the asynchronous write queue with bulk write() calls for
+    // as long as the port accepts data. The data is peeked rather
+    // than removed from the queue so that a short write only consumes
+    // the bytes the kernel actually accepted.
+    //
+    unsigned char write_chunk[TX_WRITE_CHUNK_SIZE] ;
+    while( true )
+    {
+        const std::size_t bytes_to_write = mOutputBuffer.Peek( write_chunk,
+                                                               sizeof(write_chunk) ) ;
+        if ( 0 == bytes_to_write )
+        {
+            //
+            // The write queue is empty: stop write events for the port
+            // and wake up any thread waiting for the queue to drain.
+            //
+            mTxEventsEnabled = false ;
+            this->UpdateHandlerEvents() ;
+            //
+            // A writer may have queued more data between the peek
+            // above and the flag update without re-enabling write
+            // events. Re-check here so that transmission cannot stall
+            // with data queued.
+            //
+            if ( ! mOutputBuffer.IsEmpty() )
+            {
+                if ( ! mTxEventsEnabled.exchange(true) )
+                {
+                    this->UpdateHandlerEvents() ;
+                }
+                continue ;
+            }
+            sem_post(&mTxDrainedSemaphore);
+            this->ServicePendingWrites() ;
+            break ;
+        }
+        const ssize_t bytes_written = write( mFileDescriptor,
+                                             write_chunk,
+                                             bytes_to_write ) ;
+        mStatWriteSyscalls.fetch_add(1, std::memory_order_relaxed) ;
+        if ( bytes_written <= 0 )
+        {
+            //
+            // The port cannot accept more data right now. Write events
+            // remain enabled, so the event loop calls this method
+            // again once the port becomes writable.
+            //
+            break ;
+        }
+        mStatBytesTransmitted.fetch_add(bytes_written, std::memory_order_relaxed) ;
+        mOutputBuffer.Consume( bytes_written ) ;
+        this->ServicePendingWrites() ;
     }
     return ;
 }
 
 namespace
 {
-    const struct timeval
-    operator-( const struct timeval& firstOperand,
-               const struct timeval& secondOperand )
+    struct timespec
+    ComputeDeadline( const unsigned int msTimeout )
     {
-        /*
-         * This implementation may result in undefined behavior if the
-         * platform uses unsigned values for storing tv_sec and tv_usec
-         * members of struct timeval.
-         */
+        const int MICROSECONDS_PER_MS  = 1000 ;
+        const int MILLISECONDS_PER_SEC = 1000 ;
+        const long NANOSECONDS_PER_US  = 1000 ;
+        const long NANOSECONDS_PER_SEC = 1000000000 ;
         //
-        // Number of microseconds in a second.
+        // Get the current time. Throw an exception if we are unable to
+        // read the current time.
         //
-        const int MICROSECONDS_PER_SECOND = 1000000 ;
-        struct timeval result ;
-        //
-        // Take the difference of individual members of the two operands.
-        //
-        result.tv_sec  = firstOperand.tv_sec - secondOperand.tv_sec ;
-        result.tv_usec = firstOperand.tv_usec - secondOperand.tv_usec ;
-        //
-        // If abs(result.tv_usec) is larger than MICROSECONDS_PER_SECOND,
-        // then increment/decrement result.tv_sec accordingly.
-        //
-        if ( abs( result.tv_usec ) > MICROSECONDS_PER_SECOND )
+        struct timeval entry_time ;
+        if ( gettimeofday( &entry_time,
+                           NULL ) < 0 )
+        {
+            throw std::runtime_error( strerror(errno) ) ;
+        }
+        struct timespec deadline ;
+        deadline.tv_sec  = entry_time.tv_sec + ( msTimeout / MILLISECONDS_PER_SEC ) ;
+        deadline.tv_nsec = ( entry_time.tv_usec +
+                             ( msTimeout % MILLISECONDS_PER_SEC ) * MICROSECONDS_PER_MS ) *
+                           NANOSECONDS_PER_US ;
+        if ( deadline.tv_nsec >= NANOSECONDS_PER_SEC )
         {
-            int num_of_seconds = (result.tv_usec / MICROSECONDS_PER_SECOND ) ;
-            result.tv_sec  += num_of_seconds ;
-            result.tv_usec -= ( MICROSECONDS_PER_SECOND * num_of_seconds ) ;
+            deadline.tv_sec  += deadline.tv_nsec / NANOSECONDS_PER_SEC ;
+            deadline.tv_nsec %= NANOSECONDS_PER_SEC ;
         }
-        return result ;
+        return deadline ;
     }
 }
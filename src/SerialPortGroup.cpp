@@ -0,0 +1,187 @@
+/******************************************************************************
+ *   @file SerialPortGroup.cpp                                                *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#include "SerialPortGroup.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <sys/time.h>
+
+namespace
+{
+    /*
+     * Return the absolute CLOCK_REALTIME deadline that lies msTimeout
+     * milliseconds in the future, in the format expected by
+     * sem_timedwait().
+     */
+    struct timespec
+    ComputeDeadline( const unsigned int msTimeout )
+    {
+        const int MICROSECONDS_PER_MS  = 1000 ;
+        const int MILLISECONDS_PER_SEC = 1000 ;
+        const long NANOSECONDS_PER_US  = 1000 ;
+        const long NANOSECONDS_PER_SEC = 1000000000 ;
+
+        struct timeval entry_time ;
+        if ( gettimeofday( &entry_time,
+                           NULL ) < 0 )
+        {
+            throw std::runtime_error( strerror(errno) ) ;
+        }
+        struct timespec deadline ;
+        deadline.tv_sec  = entry_time.tv_sec + ( msTimeout / MILLISECONDS_PER_SEC ) ;
+        deadline.tv_nsec = ( entry_time.tv_usec +
+                             ( msTimeout % MILLISECONDS_PER_SEC ) * MICROSECONDS_PER_MS ) *
+                           NANOSECONDS_PER_US ;
+        if ( deadline.tv_nsec >= NANOSECONDS_PER_SEC )
+        {
+            deadline.tv_sec  += deadline.tv_nsec / NANOSECONDS_PER_SEC ;
+            deadline.tv_nsec %= NANOSECONDS_PER_SEC ;
+        }
+        return deadline ;
+    }
+}
+
+SerialPortGroup::SerialPortGroup() :
+    mMemberPorts(),
+    mDataAvailableSemaphore()
+{
+    //Initializing the semaphore used to signal data arrival
+    if ( sem_init( &mDataAvailableSemaphore,
+                   0,
+                   0 ) != 0 )
+    {
+        std::cerr << "SerialPortGroup.cpp: Could not initialize semaphore!"
+                  << std::endl ;
+    }
+}
+
+SerialPortGroup::~SerialPortGroup()
+{
+    //
+    // Detach all member ports so the event engine stops posting our
+    // semaphore before it is destroyed.
+    //
+    for( std::size_t i = 0 ; i < mMemberPorts.size() ; ++i )
+    {
+        mMemberPorts[i]->SetDataEventSemaphore( 0 ) ;
+    }
+    sem_destroy( &mDataAvailableSemaphore ) ;
+}
+
+void
+SerialPortGroup::AddPort( SerialPort& serialPort )
+{
+    //
+    // Nothing to do if the port is already a member of the group.
+    //
+    if ( std::find( mMemberPorts.begin(),
+                    mMemberPorts.end(),
+                    &serialPort ) != mMemberPorts.end() )
+    {
+        return ;
+    }
+    mMemberPorts.push_back( &serialPort ) ;
+    serialPort.SetDataEventSemaphore( &mDataAvailableSemaphore ) ;
+    return ;
+}
+
+void
+SerialPortGroup::RemovePort( SerialPort& serialPort )
+{
+    std::vector<SerialPort*>::iterator port_iterator =
+        std::find( mMemberPorts.begin(),
+                   mMemberPorts.end(),
+                   &serialPort ) ;
+    if ( mMemberPorts.end() == port_iterator )
+    {
+        return ;
+    }
+    serialPort.SetDataEventSemaphore( 0 ) ;
+    mMemberPorts.erase( port_iterator ) ;
+    return ;
+}
+
+std::size_t
+SerialPortGroup::WaitForData( PortDataEventList& dataEvents,
+                              const unsigned int msTimeout )
+{
+    dataEvents.clear() ;
+    //
+    // Compute the deadline once so repeated semaphore wakeups (for
+    // example from stale posts for data that has already been read)
+    // do not extend the overall wait.
+    //
+    struct timespec deadline ;
+    if ( msTimeout > 0 )
+    {
+        deadline = ComputeDeadline( msTimeout ) ;
+    }
+    while( true )
+    {
+        //
+        // Collect one event for every member port that currently has
+        // data buffered.
+        //
+        for( std::size_t i = 0 ; i < mMemberPorts.size() ; ++i )
+        {
+            const std::size_t bytes_available =
+                mMemberPorts[i]->GetAvailableByteCount() ;
+            if ( bytes_available > 0 )
+            {
+                PortDataEvent data_event ;
+                data_event.serialPort          = mMemberPorts[i] ;
+                data_event.numOfBytesAvailable = bytes_available ;
+                dataEvents.push_back( data_event ) ;
+            }
+        }
+        if ( ! dataEvents.empty() )
+        {
+            return dataEvents.size() ;
+        }
+        //
+        // No data anywhere yet: wait for the event engine to post the
+        // group semaphore.
+        //
+        int wait_result = 0 ;
+        if ( 0 == msTimeout )
+        {
+            wait_result = sem_wait( &mDataAvailableSemaphore ) ;
+        }
+        else
+        {
+            wait_result = sem_timedwait( &mDataAvailableSemaphore,
+                                         &deadline ) ;
+        }
+        if ( wait_result < 0 )
+        {
+            if ( ETIMEDOUT == errno )
+            {
+                return 0 ;
+            }
+            if ( EINTR != errno )
+            {
+                throw std::runtime_error( strerror(errno) ) ;
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/******************************************************************************
+ *   @file SerialPortGroup.h                                                  *
+ *                                                                            *
+ *   This program is free software; you can redistribute it and/or modify     *
+ *   it under the terms of the GNU General Public License as published by     *
+ *   the Free Software Foundation; either version 2 of the License, or        *
+ *   (at your option) any later version.                                      *
+ *                                                                            *
+ *   This program is distributed in the hope that it will be useful,          *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *   GNU General Public License for more details.                             *
+ *                                                                            *
+ *   You should have received a copy of the GNU General Public License        *
+ *   along with this program; if not, write to the                            *
+ *   Free Software Foundation, Inc.,                                          *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.                *
+ *****************************************************************************/
+
+#ifndef _SerialPortGroup_h_
+#define _SerialPortGroup_h_
+
+#include <SerialPort.h>
+
+#include <semaphore.h>
+#include <vector>
+
+/**
+ * @brief Multiplexes many serial ports behind a single wait point.
+ *
+ *        All open ports are already serviced by the one event loop of
+ *        the epoll engine; a SerialPortGroup additionally lets one
+ *        application thread sleep until *any* of its member ports has
+ *        received data and then collect a batch of "port X has N
+ *        bytes" events, instead of dedicating a blocked reader thread
+ *        to every port. Typical use:
+ *
+ *        \code
+ *        SerialPortGroup group ;
+ *        group.AddPort(port1) ;
+ *        group.AddPort(port2) ;
+ *        SerialPortGroup::PortDataEventList events ;
+ *        while( group.WaitForData(events, 1000) > 0 )
+ *        {
+ *            for( std::size_t i = 0 ; i < events.size() ; ++i )
+ *            {
+ *                events[i].serialPort->Read( buffer,
+ *                                            events[i].numOfBytesAvailable,
+ *                                            0 ) ;
+ *            }
+ *        }
+ *        \endcode
+ *
+ * @note A group must be used from a single consumer thread: AddPort,
+ *       RemovePort, and WaitForData may not be called concurrently
+ *       with each other. The member ports must not be destroyed (or
+ *       closed and reopened) while they belong to a group, and a
+ *       group should only be destroyed once its member ports have
+ *       been removed or closed - destroying it while data is still
+ *       arriving at a member port leaves a window in which the event
+ *       engine could signal the group's destroyed semaphore.
+ */
+class SerialPortGroup
+{
+public:
+    /**
+     * @brief Default Constructor.
+     */
+    SerialPortGroup() ;
+
+    /**
+     * @brief Destructor. Detaches all member ports from the group.
+     */
+    ~SerialPortGroup() ;
+
+    /**
+     * @brief An event describing data waiting at one member port.
+     */
+    struct PortDataEvent
+    {
+        /**
+         * The port at which data is waiting.
+         */
+        SerialPort* serialPort ;
+
+        /**
+         * The number of bytes buffered at the port when the event was
+         * collected. More data may have arrived since.
+         */
+        std::size_t numOfBytesAvailable ;
+    } ;
+
+    /**
+     * @brief A list of events as returned by WaitForData().
+     */
+    typedef std::vector<PortDataEvent> PortDataEventList ;
+
+    /**
+     * @brief Adds a port to the group. The port should be open;
+     *        events are only generated for data that arrives while
+     *        the port is open and a member of the group.
+     * @param serialPort The port to be added to the group.
+     */
+    void AddPort( SerialPort& serialPort ) ;
+
+    /**
+     * @brief Removes a port from the group. This method has no effect
+     *        if the port is not a member of the group.
+     * @param serialPort The port to be removed from the group.
+     */
+    void RemovePort( SerialPort& serialPort ) ;
+
+    /**
+     * @brief Waits until at least one member port has received data
+     *        and collects one event per port that currently has data
+     *        buffered. If data is already waiting, the method returns
+     *        immediately without sleeping.
+     * @param dataEvents Filled with one event for each member port
+     *        that has data available. Any previous contents are
+     *        discarded.
+     * @param msTimeout The maximum time to wait for data, in
+     *        milliseconds. If msTimeout is 0, the method waits
+     *        indefinitely.
+     * @return Returns the number of collected events; 0 indicates
+     *         that the timeout expired with no data available.
+     */
+    std::size_t
+    WaitForData( PortDataEventList& dataEvents,
+                 const unsigned int msTimeout = 0 ) ;
+
+private:
+    /**
+     * The copy constructor and the assignment operator are declared
+     * private but never defined. This allows the compiler to catch
+     * attempts to copy instances of this class.
+     */
+    SerialPortGroup( const SerialPortGroup& ) ;
+    SerialPortGroup& operator=( const SerialPortGroup& ) ;
+
+    /**
+     * The member ports of the group.
+     */
+    std::vector<SerialPort*> mMemberPorts ;
+
+    /**
+     * Counting semaphore posted by the event engine whenever data is
+     * stored at any member port. WaitForData() blocks on this
+     * semaphore.
+     */
+    sem_t mDataAvailableSemaphore ;
+} ;
+
+#endif // #ifndef _SerialPortGroup_h_
@@ -20,8 +20,12 @@
 
 #include "SerialStreamBuf.h"
 
+#include <cerrno>
+#include <cstring>
 #include <fcntl.h>
 #include <strings.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
 
 using namespace std ;
 using namespace LibSerial ;
@@ -50,13 +54,16 @@ SerialStreamBuf::DEFAULT_VMIN            = 1 ;
 const short
 SerialStreamBuf::DEFAULT_VTIME           = 0 ;
 
+const std::streamsize
+SerialStreamBuf::DEFAULT_BUFFER_SIZE     = 4096 ;
+
 
 class SerialStreamBuf::Implementation
 {
 public:
     Implementation() ;
 
-    ~Implementation() { /* empty */ }
+    ~Implementation() { delete [] mInternalBuffer ; }
 
     SerialStreamBuf::BaudRateEnum
     SetBaudRate(const SerialStreamBuf::BaudRateEnum baud_rate) ;
@@ -128,6 +135,27 @@ public: // Yes. "public"
      */
     int mFileDescriptor ;
 
+    /**
+     * Internally allocated buffer memory, if any. This is null when
+     * the stream is unbuffered or when the buffer memory was provided
+     * by the caller through setbuf().
+     */
+    char* mInternalBuffer ;
+
+    /**
+     * Location and size of the get area. mGetArea is null when the
+     * stream is unbuffered.
+     */
+    char* mGetArea ;
+    std::streamsize mGetAreaSize ;
+
+    /**
+     * Location and size of the put area. mPutArea is null when the
+     * stream is unbuffered.
+     */
+    char* mPutArea ;
+    std::streamsize mPutAreaSize ;
+
     /* ------------------------------------------------------------
      * Private Methods
      * ------------------------------------------------------------
@@ -147,7 +175,15 @@ public: // Yes. "public"
 SerialStreamBuf::SerialStreamBuf() :
     mImpl( new Implementation )
 {
-    setbuf(0, 0) ;
+    //
+    // The stream starts out unbuffered so that every character
+    // reaches the serial port as soon as it is written, which
+    // existing code relies on. Buffered I/O is opt-in: call
+    // setbuf(0, DEFAULT_BUFFER_SIZE) - or setbuf() with caller-owned
+    // memory - to enable it.
+    //
+    this->SetupBuffer( 0,
+                       0 ) ;
     return ;
 }
 
@@ -170,9 +206,119 @@ SerialStreamBuf::is_open() const
     
 
 std::streambuf* 
-SerialStreamBuf::setbuf(char_type *, std::streamsize) 
+SerialStreamBuf::setbuf(char_type *buffer, std::streamsize size) 
 {
-    return std::streambuf::setbuf(0, 0) ;
+    this->SetupBuffer( buffer,
+                       size ) ;
+    return this ;
+}
+
+void
+SerialStreamBuf::SetupBuffer( char_type*      buffer,
+                              std::streamsize size )
+{
+    //
+    // Flush any buffered output before the put area disappears. Any
+    // unread buffered input is discarded.
+    //
+    if ( this->is_open() )
+    {
+        this->FlushPutArea() ;
+    }
+    delete [] mImpl->mInternalBuffer ;
+    mImpl->mInternalBuffer = 0 ;
+    //
+    // A size smaller than four cannot hold a get area with its
+    // reserved putback slot plus a put area; switch to unbuffered I/O
+    // in that case (setbuf(0, 0) requests exactly that).
+    //
+    if ( size < 4 )
+    {
+        mImpl->mGetArea     = 0 ;
+        mImpl->mGetAreaSize = 0 ;
+        mImpl->mPutArea     = 0 ;
+        mImpl->mPutAreaSize = 0 ;
+        this->setg(0, 0, 0) ;
+        this->setp(0, 0) ;
+        return ;
+    }
+    //
+    // Use the caller-provided memory if available; allocate otherwise.
+    //
+    char* buffer_memory = buffer ;
+    if ( 0 == buffer_memory )
+    {
+        buffer_memory = new char[size] ;
+        mImpl->mInternalBuffer = buffer_memory ;
+    }
+    //
+    // The first half of the memory becomes the get area and the
+    // second half the put area.
+    //
+    mImpl->mGetArea     = buffer_memory ;
+    mImpl->mGetAreaSize = size / 2 ;
+    mImpl->mPutArea     = buffer_memory + ( size / 2 ) ;
+    mImpl->mPutAreaSize = size - ( size / 2 ) ;
+    //
+    // The get area starts out empty and the put area starts out
+    // completely available.
+    //
+    this->setg(0, 0, 0) ;
+    this->setp( mImpl->mPutArea,
+                mImpl->mPutArea + mImpl->mPutAreaSize ) ;
+    return ;
+}
+
+bool
+SerialStreamBuf::IsBuffered() const
+{
+    return ( 0 != mImpl->mGetArea ) ;
+}
+
+int
+SerialStreamBuf::FlushPutArea()
+{
+    const std::streamsize pending_chars = this->pptr() - this->pbase() ;
+    if ( pending_chars > 0 )
+    {
+        //
+        // Write all pending characters to the serial port, continuing
+        // after short writes.
+        //
+        std::streamsize chars_written = 0 ;
+        while( chars_written < pending_chars )
+        {
+            const ssize_t write_result = write( mImpl->mFileDescriptor,
+                                                this->pbase() + chars_written,
+                                                pending_chars - chars_written ) ;
+            if ( write_result < 0 )
+            {
+                if ( EINTR == errno )
+                {
+                    continue ;
+                }
+                return -1 ;
+            }
+            if ( 0 == write_result )
+            {
+                return -1 ;
+            }
+            chars_written += write_result ;
+        }
+        this->setp( mImpl->mPutArea,
+                    mImpl->mPutArea + mImpl->mPutAreaSize ) ;
+    }
+    return 0 ;
+}
+
+int
+SerialStreamBuf::sync()
+{
+    if ( ! this->IsBuffered() )
+    {
+        return 0 ;
+    }
+    return this->FlushPutArea() ;
 }
 
 
@@ -187,9 +333,13 @@ SerialStreamBuf::close()
         return 0 ;
     }
     //
-    // Otherwise, close the serial port and set the file descriptor
-    // to an invalid value.
+    // Otherwise, flush any buffered output, then close the serial port
+    // and set the file descriptor to an invalid value.
     //
+    if ( this->IsBuffered() )
+    {
+        this->FlushPutArea() ;
+    }
     if ( -1 == ::close(mImpl->mFileDescriptor) ) 
     {
         //
@@ -213,6 +363,19 @@ SerialStreamBuf::close()
 std::streambuf::int_type
 SerialStreamBuf::uflow() 
 {
+    if ( this->IsBuffered() )
+    {
+        //
+        // With a get area present, uflow() is underflow() plus
+        // advancing the get pointer past the returned character.
+        //
+        const int_type next_ch = this->underflow() ;
+        if ( ! traits_type::eq_int_type(next_ch, traits_type::eof()) )
+        {
+            this->gbump(1) ;
+        }
+        return next_ch ;
+    }
     int_type next_ch = underflow() ;
     mImpl->mPutbackAvailable = false ;
     return next_ch ;
@@ -468,19 +631,106 @@ SerialStreamBuf::VTime() const
 streamsize
 SerialStreamBuf::xsgetn(char_type *s, streamsize n) 
 {
-    return mImpl->xsgetn( s, n ) ;
+    if ( ! this->IsBuffered() )
+    {
+        return mImpl->xsgetn( s, n ) ;
+    }
+    if ( (-1 == mImpl->mFileDescriptor) ||
+         (n <= 0) )
+    {
+        return 0 ;
+    }
+    //
+    // Serve as much as possible from the get area and top the result
+    // up with a single bulk read() directly into the caller's array.
+    //
+    streamsize chars_copied = this->egptr() - this->gptr() ;
+    if ( chars_copied > n )
+    {
+        chars_copied = n ;
+    }
+    if ( chars_copied > 0 )
+    {
+        std::memcpy( s,
+                     this->gptr(),
+                     chars_copied ) ;
+        this->gbump( chars_copied ) ;
+    }
+    if ( chars_copied < n )
+    {
+        const ssize_t read_result = read( mImpl->mFileDescriptor,
+                                          s + chars_copied,
+                                          n - chars_copied ) ;
+        if ( read_result > 0 )
+        {
+            chars_copied += read_result ;
+        }
+    }
+    return chars_copied ;
 }
 
 std::streamsize
 SerialStreamBuf::showmanyc() 
 {
-    return mImpl->showmanyc() ;
+    if ( ! this->IsBuffered() )
+    {
+        return mImpl->showmanyc() ;
+    }
+    if ( -1 == mImpl->mFileDescriptor )
+    {
+        return -1 ;
+    }
+    //
+    // Answer from the get area if it holds unread characters;
+    // otherwise ask the kernel how many bytes are waiting at the
+    // port.
+    //
+    if ( this->gptr() < this->egptr() )
+    {
+        return ( this->egptr() - this->gptr() ) ;
+    }
+    int num_of_bytes_available = 0 ;
+    if ( ioctl( mImpl->mFileDescriptor,
+                FIONREAD,
+                &num_of_bytes_available ) < 0 )
+    {
+        return -1 ;
+    }
+    return num_of_bytes_available ;
 }
 
 streambuf::int_type
 SerialStreamBuf::underflow() 
 {
-    return mImpl->underflow() ;
+    if ( ! this->IsBuffered() )
+    {
+        return mImpl->underflow() ;
+    }
+    if ( -1 == mImpl->mFileDescriptor )
+    {
+        return traits_type::eof() ;
+    }
+    //
+    // Serve the next character from the get area, refilling it with a
+    // bulk read() when it is exhausted. The first slot of the get
+    // area is reserved so that one character of putback is always
+    // possible after a refill.
+    //
+    if ( this->gptr() < this->egptr() )
+    {
+        return traits_type::to_int_type( *this->gptr() ) ;
+    }
+    const ssize_t read_result = read( mImpl->mFileDescriptor,
+                                      mImpl->mGetArea + 1,
+                                      mImpl->mGetAreaSize - 1 ) ;
+    if ( read_result <= 0 )
+    {
+        return traits_type::eof() ;
+    }
+    this->setg( mImpl->mGetArea,
+                mImpl->mGetArea + 1,
+                mImpl->mGetArea + 1 + read_result ) ;
+    return traits_type::to_int_type( *this->gptr() ) ;
 }
 
 
@@ -488,27 +738,141 @@ SerialStreamBuf::underflow()
 streambuf::int_type
 SerialStreamBuf::pbackfail(int_type c) 
 {
-    return mImpl->pbackfail(c) ;
+    if ( ! this->IsBuffered() )
+    {
+        return mImpl->pbackfail(c) ;
+    }
+    //
+    // Step the get pointer back if there is room, storing the
+    // character to be put back unless eof was passed in.
+    //
+    if ( this->gptr() > this->eback() )
+    {
+        this->gbump(-1) ;
+        if ( ! traits_type::eq_int_type(c, traits_type::eof()) )
+        {
+            *this->gptr() = traits_type::to_char_type(c) ;
+        }
+        return traits_type::not_eof(c) ;
+    }
+    return traits_type::eof() ;
 }
 
 
 streamsize
 SerialStreamBuf::xsputn(const char_type *s, streamsize n) 
 {
-    return mImpl->xsputn( s, n ) ;
+    if ( ! this->IsBuffered() )
+    {
+        return mImpl->xsputn( s, n ) ;
+    }
+    if ( (-1 == mImpl->mFileDescriptor) ||
+         (n <= 0) )
+    {
+        return 0 ;
+    }
+    //
+    // A request at least as large as the put area gains nothing from
+    // buffering: flush whatever is pending (to preserve ordering) and
+    // pass the caller's array directly to write(), so a bulk
+    // stream.write() costs one flush and one write instead of
+    // repeatedly filling and draining the put area.
+    //
+    if ( n >= mImpl->mPutAreaSize )
+    {
+        if ( -1 == this->FlushPutArea() )
+        {
+            return 0 ;
+        }
+        streamsize chars_written = 0 ;
+        while( chars_written < n )
+        {
+            const ssize_t write_result = write( mImpl->mFileDescriptor,
+                                                s + chars_written,
+                                                n - chars_written ) ;
+            if ( write_result < 0 )
+            {
+                if ( EINTR == errno )
+                {
+                    continue ;
+                }
+                break ;
+            }
+            if ( 0 == write_result )
+            {
+                break ;
+            }
+            chars_written += write_result ;
+        }
+        return chars_written ;
+    }
+    //
+    // Copy the characters into the put area, flushing it to the
+    // serial port whenever it fills up.
+    //
+    streamsize chars_stored = 0 ;
+    while( chars_stored < n )
+    {
+        std::streamsize available_space = this->epptr() - this->pptr() ;
+        if ( 0 == available_space )
+        {
+            if ( -1 == this->FlushPutArea() )
+            {
+                break ;
+            }
+            available_space = this->epptr() - this->pptr() ;
+        }
+        std::streamsize chars_to_copy = n - chars_stored ;
+        if ( chars_to_copy > available_space )
+        {
+            chars_to_copy = available_space ;
+        }
+        std::memcpy( this->pptr(),
+                     s + chars_stored,
+                     chars_to_copy ) ;
+        this->pbump( chars_to_copy ) ;
+        chars_stored += chars_to_copy ;
+    }
+    return chars_stored ;
 }
 
 streambuf::int_type
 SerialStreamBuf::overflow(int_type c) 
 {
-    return mImpl->overflow(c) ;
+    if ( ! this->IsBuffered() )
+    {
+        return mImpl->overflow(c) ;
+    }
+    if ( -1 == mImpl->mFileDescriptor )
+    {
+        return traits_type::eof() ;
+    }
+    //
+    // Make room in the put area and store the character in it unless
+    // eof was passed in, in which case only the flush is performed.
+    //
+    if ( -1 == this->FlushPutArea() )
+    {
+        return traits_type::eof() ;
+    }
+    if ( ! traits_type::eq_int_type(c, traits_type::eof()) )
+    {
+        *this->pptr() = traits_type::to_char_type(c) ;
+        this->pbump(1) ;
+    }
+    return traits_type::not_eof(c) ;
 }
 
 inline
 SerialStreamBuf::Implementation::Implementation() :
     mPutbackChar(0),
     mPutbackAvailable(false),
-    mFileDescriptor(-1)
+    mFileDescriptor(-1),
+    mInternalBuffer(0),
+    mGetArea(0),
+    mGetAreaSize(0),
+    mPutArea(0),
+    mPutAreaSize(0)
 {
     /* empty */
 }
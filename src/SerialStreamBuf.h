@@ -42,8 +42,19 @@ extern "C++"
          *        associated with the serial port and the standard filebuf
          *        does not provide access to it.
          *
-         *        At present, this class uses unbuffered I/O and all calls
-         *        to setbuf() will be ignored.
+         *        By default this class uses unbuffered I/O: every
+         *        character written reaches the serial port immediately
+         *        and every character read costs a system call, matching
+         *        the behavior existing applications rely on. Buffered
+         *        I/O can be enabled with setbuf() - for example
+         *        setbuf(0, DEFAULT_BUFFER_SIZE) - after which
+         *        characters are read from the serial port in bulk into
+         *        an internal get area and written out in bulk from an
+         *        internal put area, so per-character operations such as
+         *        sgetc() and sputc() are usually served from memory.
+         *        Note that with buffering enabled, output stays in the
+         *        put area until it fills up or the stream is flushed or
+         *        closed.
          *
          * @author $Author: crayzeewulf $ <A HREF="pagey@gnudom.org">Manish P. Pagey</A>
          * @version $Id: SerialStreamBuf.h,v 1.9 2005-10-17 00:19:12 crayzeewulf Exp $
@@ -220,6 +231,14 @@ extern "C++"
              */
             static const short DEFAULT_VTIME ;
 
+            /**
+             * @brief The suggested buffer size (in characters) to pass
+             *        to setbuf() when enabling buffered I/O, covering
+             *        both the get area and the put area. The stream is
+             *        unbuffered until setbuf() is called.
+             */
+            static const std::streamsize DEFAULT_BUFFER_SIZE ;
+
             /* -----------------------------------------------------------------
              * Constructors and Destructor
              * -----------------------------------------------------------------
@@ -464,22 +483,32 @@ extern "C++"
              * ----------------------------------------------------------------
              */
             /**
-             * @brief Performs an operation that is defined separately for each
-             *        class derived from streambuf. The default behavior is to
-             *        do nothing if gptr() is non-null and gptr()!=egptr().
-             *        Also, setbuf(0, 0) usually means unbuffered I/O and
-             *        setbuf(p, n) means use p[0]...p[n-1] to hold the buffered
-             *        characters. In general, this method implements the
-             *        subclass's notion of getting memory for the buffered
-             *        characters. 
-             *
-             *        In the case of SerialStreamBuffer, we want to keep using
-             *        unbuffered I/O. Hence, using this method has no effect at
-             *        present.
+             * @brief Selects the buffer used for the get and put areas.
+             *        Calling setbuf(0, 0) - or any size smaller than
+             *        four, which cannot hold the get and put areas -
+             *        switches the stream to unbuffered I/O, where every
+             *        character is read from or written to the serial
+             *        port with its own system call (this is the initial
+             *        state). Calling setbuf(p, n) with n of at least
+             *        four uses p[0]...p[n-1] to hold the buffered
+             *        characters; the first half of the memory becomes
+             *        the get area and the second half the put area. If
+             *        p is null, memory of the specified size is
+             *        allocated internally. Any buffered output is
+             *        flushed and any unread buffered input is discarded
+             *        before the buffer is replaced, so it is best to
+             *        call this method before any I/O is performed.
              */
             virtual std::streambuf* setbuf( char_type*, 
                                             std::streamsize ) ;
 
+            /**
+             * @brief Writes any characters pending in the put area to
+             *        the serial port.
+             * @return Returns 0 on success and -1 on failure.
+             */
+            virtual int sync() ;
+
             /**
              * @brief Reads upto n characters from the serial port and returns
              *        them through the character array located at s.
@@ -562,6 +591,28 @@ extern "C++"
             SerialStreamBuf( const SerialStreamBuf& ) ;
             SerialStreamBuf& operator=( const SerialStreamBuf& ) ;
 
+            /**
+             * Replace the current get and put areas with areas carved
+             * out of the specified memory, or with internally allocated
+             * memory if buffer is null. A size smaller than four
+             * switches the stream to unbuffered I/O.
+             */
+            void SetupBuffer( char_type*      buffer,
+                              std::streamsize size ) ;
+
+            /**
+             * Write any characters pending in the put area to the
+             * serial port. Returns 0 on success and -1 on failure.
+             */
+            int FlushPutArea() ;
+
+            /**
+             * Returns true iff the stream currently has get and put
+             * areas, i.e. it has not been switched to unbuffered I/O
+             * with setbuf(0, 0).
+             */
+            bool IsBuffered() const ;
+
             class Implementation ;
             boost::scoped_ptr<Implementation> mImpl ;
         